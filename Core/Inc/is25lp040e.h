@@ -37,6 +37,66 @@
 #define IS25LP_DEVICE_ID            0x13     // 4Mbit (512KB)
 #define IS25LP_JEDEC_ID             0x6013   // Memory Type + Capacity
 
+/**
+ * @define Driver configuration
+ * @brief Compile-time options, may be overridden by the build (-D)
+ */
+#ifndef IS25LP_USE_DMA
+#define IS25LP_USE_DMA              1        // Use DMA for bulk reads (needs hdmarx/hdmatx linked)
+#endif
+
+#ifndef IS25LP_DMA_THRESHOLD
+#define IS25LP_DMA_THRESHOLD        64       // Minimum length (bytes) handed to DMA
+#endif
+
+#ifndef IS25LP_USE_PREDICTOR
+#define IS25LP_USE_PREDICTOR        1        // Skip status polling until shortly before predicted completion
+#endif
+
+#ifndef IS25LP_PREDICTOR_WARMUP
+#define IS25LP_PREDICTOR_WARMUP     4        // Samples needed before predictions are used
+#endif
+
+#ifndef IS25LP_USE_LL_SPI
+#define IS25LP_USE_LL_SPI           1        // Drive short frames through the SPI FIFO (LL) instead of HAL
+#endif
+
+#ifndef IS25LP_LL_MAX_FRAME
+#define IS25LP_LL_MAX_FRAME         16       // Longest frame (bytes) sent via the LL path
+#endif
+
+#ifndef IS25LP_WRITE_TRIM_FF
+#define IS25LP_WRITE_TRIM_FF        1        // IS25LP_Write also trims leading/trailing 0xFF inside a page
+#endif
+
+#ifndef IS25LP_WCACHE_LINES
+#define IS25LP_WCACHE_LINES         0        // Write-back cache pages per handle (0 = compiled out)
+#endif
+
+#ifndef IS25LP_WCACHE_TIMEOUT_MS
+#define IS25LP_WCACHE_TIMEOUT_MS    100      // Cached pages older than this are programmed by IS25LP_AsyncTick
+#endif
+
+#ifndef IS25LP_CAL_PASSES
+#define IS25LP_CAL_PASSES           4        // Error-free pattern reads required per clock setting
+#endif
+
+#ifndef IS25LP_MAX_INSTANCES
+#define IS25LP_MAX_INSTANCES        4        // Handles that can receive DMA callbacks
+#endif
+
+#ifndef IS25LP_USE_STATS
+#define IS25LP_USE_STATS            0        // Per-opcode counters and latency histograms in the handle (0 = compiled out)
+#endif
+
+#ifndef IS25LP_STATS_BUCKETS
+#define IS25LP_STATS_BUCKETS        22       // Latency histogram buckets, the last one is open-ended (~1s and above)
+#endif
+
+#ifndef IS25LP_TRACE_ENTRIES
+#define IS25LP_TRACE_ENTRIES        0        // Bus transactions kept in the trace ring per handle (0 = compiled out)
+#endif
+
 /**
  * @enum eIS25LP_Status_t
  * @brief Status codes for IS25LP operations
@@ -47,6 +107,133 @@ typedef enum
 	IS25LP_OK = true
 } eIS25LP_Status_t;
 
+/**
+ * @enum eIS25LP_EraseType_t
+ * @brief Erase granularity for IS25LP_EraseAsync
+ */
+typedef enum
+{
+    IS25LP_ERASE_SECTOR = 0,    // 4KB sector (0x20)
+    IS25LP_ERASE_BLOCK_32K,     // 32KB block (0x52)
+    IS25LP_ERASE_BLOCK_64K,     // 64KB block (0xD8)
+    IS25LP_ERASE_CHIP           // Entire chip (0xC7)
+} eIS25LP_EraseType_t;
+
+/**
+ * @enum eIS25LP_AsyncState_t
+ * @brief State of the asynchronous operation state machine
+ */
+typedef enum
+{
+    IS25LP_ASYNC_IDLE = 0,      // No asynchronous operation pending
+    IS25LP_ASYNC_READ,          // DMA read in flight
+    IS25LP_ASYNC_PROGRAM,       // Page program running (WIP set)
+    IS25LP_ASYNC_ERASE          // Erase running (WIP set)
+} eIS25LP_AsyncState_t;
+
+/**
+ * @enum eIS25LP_Operation_t
+ * @brief Operation classes with their own busy-wait timing
+ */
+typedef enum
+{
+    IS25LP_OP_READ = 0,         // Ready check before reads/commands
+    IS25LP_OP_PAGE_PROGRAM,     // Page program (tPP ~0.45ms typ)
+    IS25LP_OP_SECTOR_ERASE,     // 4KB sector erase (~70ms typ)
+    IS25LP_OP_BLOCK_ERASE_32K,  // 32KB block erase (~130ms typ)
+    IS25LP_OP_BLOCK_ERASE_64K,  // 64KB block erase (~200ms typ)
+    IS25LP_OP_CHIP_ERASE,       // Chip erase (~1.5s typ)
+    IS25LP_OP_COUNT
+} eIS25LP_Operation_t;
+
+/**
+ * @enum eIS25LP_StatOpcode_t
+ * @brief Command groups counted by the instrumentation (IS25LP_USE_STATS)
+ */
+typedef enum
+{
+    IS25LP_STAT_READ = 0,           // Read Data (0x03)
+    IS25LP_STAT_FAST_READ,          // Fast Read (0x0B), includes streams
+    IS25LP_STAT_PAGE_PROGRAM,       // Page Program (0x02)
+    IS25LP_STAT_SECTOR_ERASE,       // Sector Erase (0x20)
+    IS25LP_STAT_BLOCK_ERASE_32K,    // Block Erase 32KB (0x52)
+    IS25LP_STAT_BLOCK_ERASE_64K,    // Block Erase 64KB (0xD8)
+    IS25LP_STAT_CHIP_ERASE,         // Chip Erase (0xC7)
+    IS25LP_STAT_WRITE_ENABLE,       // Write Enable (0x06)
+    IS25LP_STAT_READ_STATUS,        // Read Status Register (0x05), one per poll
+    IS25LP_STAT_READ_FUNCTION,      // Read Function Register (0x48)
+    IS25LP_STAT_SUSPEND,            // Program/Erase Suspend (0x75)
+    IS25LP_STAT_RESUME,             // Program/Erase Resume (0x7A)
+    IS25LP_STAT_ID,                 // JEDEC, Manufacturer/Device and Unique ID
+    IS25LP_STAT_OTHER,              // Anything else
+    IS25LP_STAT_OPCODE_COUNT
+} eIS25LP_StatOpcode_t;
+
+/**
+ * @enum eIS25LP_PollMode_t
+ * @brief Status register polling method used while waiting for WIP = 0
+ */
+typedef enum
+{
+    IS25LP_POLL_DELAY_1MS = 0,  // One RDSR per HAL_Delay(1) (SysTick granularity)
+    IS25LP_POLL_BACKOFF_US,     // One RDSR per interval_us microsecond busy-wait
+    IS25LP_POLL_CONTINUOUS      // One RDSR command, status streamed under one CS assertion
+} eIS25LP_PollMode_t;
+
+/**
+ * @enum eIS25LP_CSMode_t
+ * @brief How the chip select line is driven
+ */
+typedef enum
+{
+    IS25LP_CS_GPIO = 0,         // cs_gpio toggled through cached BSRR/BRR writes
+    IS25LP_CS_HW_NSS            // SPI NSS output (SSOE), asserted while SPE = 1
+} eIS25LP_CSMode_t;
+
+/**
+ * @struct sIS25LP_PollPolicy_t
+ * @brief Polling policy of one operation class
+ */
+typedef struct
+{
+    eIS25LP_PollMode_t mode;    // Polling method
+    uint32_t interval_us;       // Delay between status reads (IS25LP_POLL_BACKOFF_US only)
+} sIS25LP_PollPolicy_t;
+
+struct sIS25LP_Handle;
+struct sIS25LP_ReadCache;
+
+/**
+ * @brief Completion callback for asynchronous operations
+ * @param handle: Handle the operation ran on
+ * @param status: IS25LP_OK on success, IS25LP_ERROR on failure or timeout
+ * @param context: User pointer passed when the operation was started
+ */
+typedef void ( *IS25LP_Callback_t )( struct sIS25LP_Handle *handle, eIS25LP_Status_t status, void *context );
+
+/**
+ * @brief Consumer callback for IS25LP_ReadStream
+ * @param handle: Handle the stream runs on
+ * @param address: Flash address of the first byte in data
+ * @param data: Chunk that was just read (valid until the callback returns)
+ * @param length: Number of bytes in data
+ * @param context: User pointer passed to IS25LP_ReadStream
+ * @retval IS25LP_OK to continue, IS25LP_ERROR to abort the stream
+ */
+typedef eIS25LP_Status_t ( *IS25LP_StreamSink_t )( struct sIS25LP_Handle *handle, uint32_t address, const uint8_t *data, uint32_t length, void *context );
+
+/**
+ * @brief Per-page transform hook for IS25LP_WritePipelined
+ * @param handle: Handle the write runs on
+ * @param address: Flash address the page slice will be programmed to
+ * @param source: Caller data for this slice
+ * @param page: Staging buffer to fill with the transformed slice
+ * @param length: Number of bytes in the slice (up to IS25LP_PAGE_SIZE)
+ * @param context: User pointer passed to IS25LP_WritePipelined
+ * @retval IS25LP_OK to continue, IS25LP_ERROR to abort the write
+ */
+typedef eIS25LP_Status_t ( *IS25LP_PrepareHook_t )( struct sIS25LP_Handle *handle, uint32_t address, const uint8_t *source, uint8_t *page, uint16_t length, void *context );
+
 /**
  * @struct sIS25LP_GPIO_t
  * @brief GPIO pin configuration
@@ -57,6 +244,223 @@ typedef struct
     uint16_t pin;               // GPIO pin (e.g., GPIO_PIN_4)
 } sIS25LP_GPIO_t;
 
+/**
+ * @struct sIS25LP_ChipSelect_t
+ * @brief Cached chip select registers (set up by IS25LP_Init)
+ */
+typedef struct
+{
+    volatile uint32_t *set_reg;         // GPIO BSRR (drives CS high)
+    volatile uint32_t *reset_reg;       // GPIO BRR (drives CS low)
+    uint32_t mask;                      // Pin mask
+} sIS25LP_ChipSelect_t;
+
+/**
+ * @struct sIS25LP_Clock_t
+ * @brief SPI clock limits per opcode class (BaudRatePrescaler values)
+ */
+typedef struct
+{
+    uint32_t read_prescaler;            // Normal Read (0x03), fC limited
+    uint32_t fast_prescaler;            // All other commands incl. Fast Read (0x0B), fCT limited
+} sIS25LP_Clock_t;
+
+/**
+ * @struct sIS25LP_TransferResult_t
+ * @brief Outcome of one DMA read, kept after later transfers (IS25LP_FastReadDMAResult)
+ */
+typedef struct
+{
+    volatile bool done;                 // Set once the transfer finished
+    volatile eIS25LP_Status_t status;   // Its result, valid when done
+} sIS25LP_TransferResult_t;
+
+/**
+ * @struct sIS25LP_Transfer_t
+ * @brief DMA transfer state (managed by the driver)
+ */
+typedef struct
+{
+    uint8_t *buffer;                    // Next DMA destination
+    uint32_t remaining;                 // Bytes not yet handed to DMA
+    volatile bool busy;                 // Transfer in flight (CS held low)
+    bool hold_cs;                       // Keep CS low after success (streaming)
+    volatile eIS25LP_Status_t status;   // Result of the last transfer
+    uint32_t address;                   // Flash address of the first byte
+    uint8_t *start;                     // First destination byte
+    uint32_t length;                    // Total length (cache overlay on completion)
+    sIS25LP_TransferResult_t *result;   // Also receives the outcome of this transfer, NULL if unused
+} sIS25LP_Transfer_t;
+
+#define IS25LP_CACHE_INVALID        0xFFFFFFFFUL    // Unused cache line
+
+/**
+ * @struct sIS25LP_CacheLine_t
+ * @brief One page of the write-back cache
+ */
+typedef struct
+{
+    uint32_t address;                   // Page address, IS25LP_CACHE_INVALID if unused
+    uint16_t first;                     // Dirty window start (offset in page)
+    uint16_t last;                      // Dirty window end (exclusive)
+    uint32_t tick;                      // HAL_GetTick() of the first write
+    bool due;                           // Older than IS25LP_WCACHE_TIMEOUT_MS, programmed by the next tick/write/flush
+    uint8_t data[ IS25LP_PAGE_SIZE ];   // AND of all pending writes, 0xFF elsewhere
+} sIS25LP_CacheLine_t;
+
+/**
+ * @struct sIS25LP_Stream_t
+ * @brief Ping-pong buffers for IS25LP_ReadStream (set with IS25LP_SetStreamBuffers)
+ */
+typedef struct
+{
+    uint8_t *buffer[ 2 ];               // Chunk buffers, filled alternately
+    uint16_t chunk_size;                // Size of each buffer in bytes
+} sIS25LP_Stream_t;
+
+/**
+ * @struct sIS25LP_Async_t
+ * @brief Asynchronous operation state (managed by the driver)
+ */
+typedef struct
+{
+    volatile eIS25LP_AsyncState_t state;    // Current state
+    uint32_t address;                       // Next address to program
+    const uint8_t *buffer;                  // Next source byte to program
+    uint32_t remaining;                     // Bytes left to program
+    uint32_t tickstart;                     // Start of the running busy phase
+    uint32_t timeout_ms;                    // Timeout of the running busy phase
+    IS25LP_Callback_t callback;             // Completion callback (may be NULL)
+    void *context;                          // User pointer for the callback
+} sIS25LP_Async_t;
+
+/**
+ * @struct sIS25LP_Suspend_t
+ * @brief Program/erase suspend state (managed by the driver)
+ */
+typedef struct
+{
+    bool active;                // Device held for reads by IS25LP_Suspend()
+    bool suspended;             // A program/erase was actually suspended (PSUS/ESUS set)
+    uint32_t suspend_us;        // IS25LP_GetMicros() when it was suspended
+    uint32_t resume_us;         // IS25LP_GetMicros() of the last resume (tRS reference)
+    uint32_t count;             // Number of suspends since IS25LP_Init()
+} sIS25LP_Suspend_t;
+
+/**
+ * @struct sIS25LP_TimingStats_t
+ * @brief Measured busy time of one operation class
+ * 
+ * @details Durations are measured from the end of the command (CS high)
+ *          to WIP = 0 in blocking waits. avg_us is an EWMA (alpha 1/8),
+ *          dev_us the EWMA of the absolute deviation (alpha 1/4).
+ */
+typedef struct
+{
+    uint32_t count;             // Number of measured operations
+    uint32_t last_us;           // Last measured duration
+    uint32_t last_address;      // Address of the last measured operation
+    uint32_t min_us;            // Shortest measured duration
+    uint32_t max_us;            // Longest measured duration
+    uint32_t avg_us;            // Smoothed duration
+    uint32_t dev_us;            // Smoothed absolute deviation
+} sIS25LP_TimingStats_t;
+
+/**
+ * @struct sIS25LP_Timing_t
+ * @brief Busy-time model (managed by the driver)
+ */
+typedef struct
+{
+    eIS25LP_Operation_t pending_op;                 // Operation in flight (IS25LP_OP_COUNT if none)
+    uint32_t issue_us;                              // IS25LP_GetMicros() when it was issued
+    uint32_t issue_address;                         // Address it was issued for
+    sIS25LP_TimingStats_t stats[ IS25LP_OP_COUNT ]; // Learned statistics per operation
+} sIS25LP_Timing_t;
+
+/**
+ * @struct sIS25LP_OpcodeStats_t
+ * @brief Bus transactions of one command group
+ * 
+ * @details A transaction runs from CS low to CS high. Histogram bucket 0
+ *          counts 0us, bucket n counts [2^(n-1), 2^n) us.
+ */
+typedef struct
+{
+    uint32_t count;                                 // Transactions
+    uint32_t errors;                                // Failed or timed out SPI/DMA transfers
+    uint32_t bytes;                                 // Bytes clocked (command, address, dummy and data)
+    uint32_t time_us;                               // Total time with CS low
+    uint32_t histogram[ IS25LP_STATS_BUCKETS ];     // Transaction time, log2 buckets
+} sIS25LP_OpcodeStats_t;
+
+/**
+ * @struct sIS25LP_WaitStats_t
+ * @brief Time spent in the ready wait of one operation class
+ * 
+ * @details Covers the predictor delay and the status polling, the RDSR
+ *          transactions are also counted under IS25LP_STAT_READ_STATUS.
+ */
+typedef struct
+{
+    uint32_t count;                                 // Waits that had to poll
+    uint32_t skipped;                               // Waits answered without polling (device known idle)
+    uint32_t timeouts;                              // Waits that gave up
+    uint32_t time_us;                               // Total time spent waiting
+    uint32_t histogram[ IS25LP_STATS_BUCKETS ];     // Wait time, log2 buckets
+} sIS25LP_WaitStats_t;
+
+/**
+ * @struct sIS25LP_Stats_t
+ * @brief Instrumentation counters of one handle (IS25LP_GetStats)
+ */
+typedef struct
+{
+    sIS25LP_OpcodeStats_t opcode[ IS25LP_STAT_OPCODE_COUNT ];   // Per command group
+    sIS25LP_WaitStats_t wait[ IS25LP_OP_COUNT ];                // Per IS25LP_WaitForReady operation class
+    uint32_t open_us;                                           // CS low time of the running transaction (driver internal)
+    uint8_t open;                                               // Its command group, IS25LP_STAT_OPCODE_COUNT if none (driver internal)
+} sIS25LP_Stats_t;
+
+#if IS25LP_TRACE_ENTRIES > 0
+#define IS25LP_TRACE_MAGIC          0x52545349UL    // "ISTR" in memory, marks a trace dump
+#define IS25LP_TRACE_NO_ADDRESS     0xFFFFFFFFUL    // Transaction without a 3-byte address header
+
+/**
+ * @struct sIS25LP_TraceRecord_t
+ * @brief One bus transaction (CS low to CS high), 16 bytes
+ */
+typedef struct
+{
+    uint32_t start_us;                  // IS25LP_GetMicros() at CS low
+    uint32_t end_us;                    // IS25LP_GetMicros() at CS high
+    uint32_t address;                   // Bytes 1-3 of the command header, IS25LP_TRACE_NO_ADDRESS if shorter
+    uint16_t length;                    // Bytes clocked including the header, saturates at 0xFFFF
+    uint8_t opcode;                     // Command byte
+    uint8_t status;                     // IS25LP_OK, IS25LP_ERROR if a transfer failed
+} sIS25LP_TraceRecord_t;
+
+/**
+ * @struct sIS25LP_Trace_t
+ * @brief Transaction trace ring (dump it as raw memory, see Host/trace_decode.c)
+ * 
+ * @details The 16-byte header lets a decoder check a dump without the
+ *          build configuration. Record head % entries is written next,
+ *          the newest head records (at most entries) are valid.
+ */
+typedef struct
+{
+    uint32_t magic;                     // IS25LP_TRACE_MAGIC
+    uint16_t record_size;               // sizeof( sIS25LP_TraceRecord_t )
+    uint16_t entries;                   // IS25LP_TRACE_ENTRIES
+    volatile uint32_t head;             // Records committed since the last clear
+    volatile uint8_t open;              // Record at head is being filled (transaction running)
+    uint8_t enabled;                    // Recording on (IS25LP_TraceEnable)
+    uint16_t reserved;
+    sIS25LP_TraceRecord_t records[ IS25LP_TRACE_ENTRIES ];
+} sIS25LP_Trace_t;
+#endif
+
 /**
  * @struct sIS25LP_Handle_t
  * @brief Handle structure for IS25LP Flash instance
@@ -65,12 +469,38 @@ typedef struct
  *          needed to communicate with the Flash chip. It allows multiple
  *          Flash instances on different SPI buses with different GPIO pins.
  */
-typedef struct
+typedef struct sIS25LP_Handle
 {
     SPI_HandleTypeDef *spi_handle;  // Pointer to SPI handle
     sIS25LP_GPIO_t cs_gpio;         // Chip Select (CS) GPIO configuration
     sIS25LP_GPIO_t wp_gpio;         // Write Protect (WP) GPIO configuration
+    eIS25LP_CSMode_t cs_mode;       // Chip select method (IS25LP_CS_GPIO unless the SPI is set to hardware NSS output)
+    sIS25LP_ChipSelect_t cs;        // Cached chip select registers (driver internal)
+    sIS25LP_Clock_t clock;          // SPI prescaler per opcode class (IS25LP_CalibrateClock)
+    bool erase_skip_blank;          // Blocking erases skip units that are already blank (IS25LP_IsBlank)
+    bool read_suspend;              // Blocking reads suspend a running async program/erase (IS25LP_Suspend)
+    bool shared_spi;                // Other handles use the same SPI, their DMA reads are waited for (IS25LP_BusAttach)
+    uint32_t skipped_pages;         // Page programs IS25LP_Write left out because the source was all 0xFF
+    struct sIS25LP_ReadCache *rcache;   // Attached read cache (IS25LP_ReadCacheInit), NULL if none
+    uint32_t modify_count;          // Incremented by every program, erase and cached write
+#if IS25LP_WCACHE_LINES > 0
+    sIS25LP_CacheLine_t wcache[ IS25LP_WCACHE_LINES ];  // Write-back page cache (driver internal)
+#endif
     bool initialized;               // Initialization status flag
+    bool device_idle;               // WIP known to be 0 (no program/erase issued since the last successful wait)
+    sIS25LP_Transfer_t xfer;        // DMA transfer state (driver internal)
+    sIS25LP_Stream_t stream;        // Streaming read buffers (IS25LP_SetStreamBuffers)
+    uint8_t *sector_buffer;         // IS25LP_SECTOR_SIZE image for IS25LP_Update erases (IS25LP_SetSectorBuffer)
+    sIS25LP_Async_t async;          // Asynchronous operation state (driver internal)
+    sIS25LP_Suspend_t suspend;      // Program/erase suspend state (driver internal)
+    sIS25LP_PollPolicy_t poll[ IS25LP_OP_COUNT ];   // Ready polling policy per operation (defaults set by IS25LP_Init)
+    sIS25LP_Timing_t timing;        // Busy-time model (driver internal)
+#if IS25LP_USE_STATS
+    sIS25LP_Stats_t stats;          // Instrumentation counters (IS25LP_GetStats)
+#endif
+#if IS25LP_TRACE_ENTRIES > 0
+    sIS25LP_Trace_t trace;          // Transaction trace ring (IS25LP_TraceEnable)
+#endif
 } sIS25LP_Handle_t;
 
 /**
@@ -96,10 +526,13 @@ typedef struct
  * 
  * @details Initializes the Flash memory by:
  *          - Storing hardware configuration in handle
+ *          - Registering for DMA callbacks (fails with DMA linked when
+ *            IS25LP_MAX_INSTANCES handles are already registered)
  *          - Setting CS to idle state (high)
  *          - Reading and verifying JEDEC ID
  *          - Checking manufacturer ID (0x9D for ISSI)
  *          - Checking device capacity (0x13 for 4Mbit)
+ *          - Loading default polling policies
  *          - Setting initialized flag
  */
 eIS25LP_Status_t IS25LP_Init(sIS25LP_Handle_t *handle);
@@ -156,6 +589,26 @@ eIS25LP_Status_t IS25LP_ReadUniqueID(sIS25LP_Handle_t *handle, uint8_t *unique_i
  */
 eIS25LP_Status_t IS25LP_GetDeviceInfo(sIS25LP_Handle_t *handle, sIS25LP_DeviceInfo_t *info);
 
+/**
+ * @brief  Find the fastest reliable SPI clock for each read opcode
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Page in a sector reserved for calibration
+ * @param  program: Allow writing the pattern when it is missing
+ * @retval IS25LP_OK on success, IS25LP_ERROR if the pattern is missing (and
+ *         program is false) or even the slowest clock fails; handle->clock
+ *         is left as it was then
+ * 
+ * @details - With program set, writes a 256-byte pattern covering every byte
+ *            value into the page (erasing its sector) if it is not there
+ *          - Reads the pattern with 0x03 and 0x0B at each prescaler, slowest
+ *            first, IS25LP_CAL_PASSES times via DMA and via the short-frame path
+ *          - Clocks above the datasheet limits (fC 50MHz, fCT 104MHz) are skipped
+ *          - Results are stored in handle->clock and applied per command
+ * @warning With program set, the sector containing address is erased
+ *          whenever the pattern is not found
+ */
+eIS25LP_Status_t IS25LP_CalibrateClock(sIS25LP_Handle_t *handle, uint32_t address, bool program);
+
 /**
  * @brief  Read data from Flash memory
  * @param  handle: Pointer to IS25LP handle structure
@@ -167,8 +620,10 @@ eIS25LP_Status_t IS25LP_GetDeviceInfo(sIS25LP_Handle_t *handle, sIS25LP_DeviceIn
  * @details - Can read any number of bytes
  *          - Can cross page and sector boundaries
  *          - Validates address range and buffer pointer
- *          - Waits for Flash ready before reading
+ *          - Waits for Flash ready before reading (skipped while the
+ *            device is known idle, see device_idle)
  *          - Uses standard Read command (0x03)
+ *          - Lengths >= IS25LP_DMA_THRESHOLD are received via DMA
  */
 eIS25LP_Status_t IS25LP_Read(sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length);
 
@@ -186,9 +641,136 @@ eIS25LP_Status_t IS25LP_Read(sIS25LP_Handle_t *handle, uint32_t address, uint8_t
  *          - Requires 1 dummy byte after address
  *          - Uses Fast Read command (0x0B)
  *          - Supports higher SPI clock frequencies than standard read
+ *          - Lengths >= IS25LP_DMA_THRESHOLD are received via DMA
  */
 eIS25LP_Status_t IS25LP_FastRead(sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length);
 
+/**
+ * @brief  Start a DMA read from Flash memory (non-blocking)
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address (0x000000 - 0x07FFFF)
+ * @param  buffer: Pointer to buffer for read data (must stay valid until done)
+ * @param  length: Number of bytes to read
+ * @retval IS25LP_OK if the transfer was started, IS25LP_ERROR on failure
+ * 
+ * @details - Uses standard Read command (0x03)
+ *          - Sends command/address, then receives data via DMA while the
+ *            TX channel clocks out dummy bytes
+ *          - CS stays low until the last byte arrived, reads larger than
+ *            65535 bytes are chained inside the DMA completion callback
+ *          - Poll IS25LP_IsTransferBusy() or IS25LP_WaitTransfer() for the result
+ */
+eIS25LP_Status_t IS25LP_ReadDMA(sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief  Start a DMA fast read from Flash memory (non-blocking)
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address (0x000000 - 0x07FFFF)
+ * @param  buffer: Pointer to buffer for read data (must stay valid until done)
+ * @param  length: Number of bytes to read
+ * @retval IS25LP_OK if the transfer was started, IS25LP_ERROR on failure
+ * 
+ * @details Same as IS25LP_ReadDMA but uses Fast Read command (0x0B)
+ *          with 1 dummy byte after the address.
+ */
+eIS25LP_Status_t IS25LP_FastReadDMA(sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief  Start a DMA fast read that reports its own outcome
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address (0x000000 - 0x07FFFF)
+ * @param  buffer: Pointer to buffer for read data (must stay valid until done)
+ * @param  length: Number of bytes to read
+ * @param  result: Cleared here, filled in when this transfer finishes
+ * @retval IS25LP_OK if the transfer was started, IS25LP_ERROR on failure
+ * 
+ * @details Same as IS25LP_FastReadDMA. IS25LP_WaitTransfer() returns the
+ *          status of the last transfer, which is another one if a blocking
+ *          call already waited for this read and started its own. result
+ *          keeps the status of this read.
+ */
+eIS25LP_Status_t IS25LP_FastReadDMAResult(sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length, sIS25LP_TransferResult_t *result);
+
+/**
+ * @brief  Check if a DMA transfer is still in flight
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval true while the transfer is running, false otherwise
+ */
+bool IS25LP_IsTransferBusy(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Wait for a DMA transfer to complete
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  timeout_ms: Maximum time to wait in milliseconds
+ * @retval IS25LP_OK if the transfer completed successfully, IS25LP_ERROR on
+ *         failure or timeout (the transfer is aborted on timeout)
+ */
+eIS25LP_Status_t IS25LP_WaitTransfer(sIS25LP_Handle_t *handle, uint32_t timeout_ms);
+
+/**
+ * @brief  Timeout for a transfer at the current SPI clock
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  length: Number of bytes on the wire
+ * @retval Timeout in milliseconds for IS25LP_WaitTransfer()
+ * 
+ * @details Scales with length and the prescaler in use (including the one
+ *          IS25LP_CalibrateClock picked), with the driver's usual margin.
+ */
+uint32_t IS25LP_TransferTimeout(sIS25LP_Handle_t *handle, uint32_t length);
+
+/**
+ * @brief  Set the ping-pong buffers used by IS25LP_ReadStream
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  buffer0: First chunk buffer
+ * @param  buffer1: Second chunk buffer
+ * @param  chunk_size: Size of each buffer in bytes
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ */
+eIS25LP_Status_t IS25LP_SetStreamBuffers(sIS25LP_Handle_t *handle, uint8_t *buffer0, uint8_t *buffer1, uint16_t chunk_size);
+
+/**
+ * @brief  Set the sector image buffer used by IS25LP_Update
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  buffer: IS25LP_SECTOR_SIZE bytes, owned by this handle only
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ */
+eIS25LP_Status_t IS25LP_SetSectorBuffer(sIS25LP_Handle_t *handle, uint8_t *buffer);
+
+/**
+ * @brief  Read a range chunk by chunk into a consumer callback
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address (0x000000 - 0x07FFFF)
+ * @param  length: Number of bytes to read
+ * @param  sink: Called once per chunk from the caller's context
+ * @param  context: User pointer passed to the sink
+ * @retval IS25LP_OK if the whole range was delivered, IS25LP_ERROR on failure
+ *         or when the sink aborted
+ * 
+ * @details - Uses Fast Read command (0x0B) under a single CS assertion
+ *          - While the sink consumes one buffer, DMA fills the other one
+ *          - Falls back to blocking chunk reads when no DMA is linked
+ *          - Blocks until the stream is finished
+ */
+eIS25LP_Status_t IS25LP_ReadStream(sIS25LP_Handle_t *handle, uint32_t address, uint32_t length, IS25LP_StreamSink_t sink, void *context);
+
+/**
+ * @brief  SPI DMA completion hook
+ * @param  hspi: SPI handle passed to HAL_SPI_TxRxCpltCallback()
+ * 
+ * @details Must be called from HAL_SPI_TxRxCpltCallback(). Chains the next
+ *          DMA chunk or releases CS when the transfer is finished.
+ */
+void IS25LP_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief  SPI DMA error hook
+ * @param  hspi: SPI handle passed to HAL_SPI_ErrorCallback()
+ * 
+ * @details Must be called from HAL_SPI_ErrorCallback(). Releases CS and
+ *          marks the running transfer as failed.
+ */
+void IS25LP_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
 /**
  * @brief  Write one page to Flash memory
  * @param  handle: Pointer to IS25LP handle structure
@@ -219,9 +801,76 @@ eIS25LP_Status_t IS25LP_WritePage(sIS25LP_Handle_t *handle, uint32_t address, co
  *          - Splits write into multiple page operations
  *          - Sector(s) must be erased before writing
  *          - More convenient than WritePage for large data
+ *          - Pages whose source is all 0xFF are not programmed (counted in
+ *            handle->skipped_pages), with IS25LP_WRITE_TRIM_FF leading and
+ *            trailing 0xFF bytes are trimmed from the programmed slice
  */
 eIS25LP_Status_t IS25LP_Write(sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length);
 
+/**
+ * @brief  Program all writes pending in the write-back cache
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details Only relevant with IS25LP_WCACHE_LINES > 0. There IS25LP_Write
+ *          merges data into RAM pages and programs a page once it is
+ *          complete, evicted, flushed here, or once it is older than
+ *          IS25LP_WCACHE_TIMEOUT_MS (by IS25LP_AsyncTick while no async
+ *          operation runs, else by the next IS25LP_Write). Reads see
+ *          pending data, erases drop pending data of the erased unit. A
+ *          page whose program fails stays cached and is retried, so
+ *          IS25LP_ERROR here means data is still pending.
+ */
+eIS25LP_Status_t IS25LP_Flush(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Write data with a per-page transform overlapped with programming
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address
+ * @param  buffer: Pointer to data to write
+ * @param  length: Number of bytes to write
+ * @param  prepare: Transform hook (CRC, whitening, encryption...), NULL to write buffer as is
+ * @param  context: User pointer passed to the hook
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details - Page N+1 is prepared into a staging buffer while page N is
+ *            still programming (tPP), then issued as soon as WIP clears
+ *          - Same page splitting and 0xFF skipping as IS25LP_Write, which
+ *            is this function without a hook
+ *          - Sector(s) must be erased before writing
+ */
+eIS25LP_Status_t IS25LP_WritePipelined(sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_PrepareHook_t prepare, void *context);
+
+/**
+ * @brief  Update data in place (read-modify-write)
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address
+ * @param  data: New contents
+ * @param  length: Number of bytes to update
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details - Works sector by sector, no prior erase needed
+ *          - If the new data only clears bits (1->0), the differing pages
+ *            are programmed directly without an erase
+ *          - Otherwise the sector is read into the buffer set with
+ *            IS25LP_SetSectorBuffer, merged, erased and its non-blank
+ *            pages are programmed again (fails without a buffer)
+ *          - Unchanged sectors are not touched at all
+ */
+eIS25LP_Status_t IS25LP_Update(sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief  Check if a range is erased
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address
+ * @param  length: Number of bytes to check
+ * @retval true if every byte is 0xFF, false otherwise or on read failure
+ * 
+ * @details Reads 256-byte chunks and compares them word by word against
+ *          0xFFFFFFFF, returning at the first programmed word.
+ */
+bool IS25LP_IsBlank(sIS25LP_Handle_t *handle, uint32_t address, uint32_t length);
+
 /**
  * @brief  Erase a 4KB sector
  * @param  handle: Pointer to IS25LP handle structure
@@ -277,4 +926,209 @@ eIS25LP_Status_t IS25LP_EraseBlock64K(sIS25LP_Handle_t *handle, uint32_t address
  */
 eIS25LP_Status_t IS25LP_EraseChip(sIS25LP_Handle_t *handle);
 
+/**
+ * @brief  Erase a range with the fastest combination of erase commands
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  start: Start address (4KB aligned)
+ * @param  length: Number of bytes to erase (multiple of 4KB)
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure or unaligned range
+ * 
+ * @details - Plans the minimal-time mix of 64KB, 32KB and 4KB erases that
+ *            covers exactly the range, honouring block alignment
+ *          - Uses chip erase for the whole device when that is faster
+ *          - Costs are the learned averages (IS25LP_GetTimingStats) once
+ *            warmed up, datasheet typical values before
+ */
+eIS25LP_Status_t IS25LP_EraseRange(sIS25LP_Handle_t *handle, uint32_t start, uint32_t length);
+
+/**
+ * @brief  Start an asynchronous read
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address (0x000000 - 0x07FFFF)
+ * @param  buffer: Pointer to buffer for read data (must stay valid until done)
+ * @param  length: Number of bytes to read
+ * @param  callback: Completion callback (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if the operation was started, IS25LP_ERROR on failure
+ * 
+ * @details - Uses Fast Read command (0x0B) via DMA
+ *          - Completion is reported from the DMA interrupt
+ *          - Requires DMA channels linked to the SPI handle
+ */
+eIS25LP_Status_t IS25LP_ReadAsync(sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context);
+
+/**
+ * @brief  Start an asynchronous multi-page write
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address
+ * @param  buffer: Pointer to data to write (must stay valid until done)
+ * @param  length: Number of bytes to write
+ * @param  callback: Completion callback (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if the operation was started, IS25LP_ERROR on failure
+ * 
+ * @details - Issues the first page program immediately
+ *          - IS25LP_AsyncTick() polls WIP and issues the following pages
+ *          - Completion is reported from IS25LP_AsyncTick()
+ *          - Sector(s) must be erased before writing
+ */
+eIS25LP_Status_t IS25LP_WriteAsync(sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context);
+
+/**
+ * @brief  Start an asynchronous erase
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  type: Erase granularity (sector, 32KB/64KB block, chip)
+ * @param  address: Any address within the unit (ignored for chip erase)
+ * @param  callback: Completion callback (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if the operation was started, IS25LP_ERROR on failure
+ * 
+ * @details - Issues the erase command immediately
+ *          - IS25LP_AsyncTick() polls WIP and reports completion
+ */
+eIS25LP_Status_t IS25LP_EraseAsync(sIS25LP_Handle_t *handle, eIS25LP_EraseType_t type, uint32_t address, IS25LP_Callback_t callback, void *context);
+
+/**
+ * @brief  Advance the asynchronous state machine
+ * @param  handle: Pointer to IS25LP handle structure
+ * 
+ * @details Call periodically from the context that makes the other
+ *          driver calls (superloop or RTOS task), never from an interrupt:
+ *          it runs SPI transactions without a bus lock, which would
+ *          interleave with a blocking transfer, IS25LP_Suspend() or a chip
+ *          on the same shared_spi bus. While a program or erase is
+ *          running, each call reads the status register once and either
+ *          issues the next page or completes the operation. Does nothing
+ *          during DMA reads. While idle, programs one write-back cache
+ *          page older than IS25LP_WCACHE_TIMEOUT_MS per call.
+ */
+void IS25LP_AsyncTick(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Check if an asynchronous operation is pending
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval true while an operation is pending, false otherwise
+ * 
+ * @details Blocking functions return IS25LP_ERROR while this is true,
+ *          except reads when read_suspend is set in the handle.
+ */
+bool IS25LP_IsAsyncBusy(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Suspend the running asynchronous program or erase (0x75 command)
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval IS25LP_OK when the array is readable, IS25LP_ERROR otherwise
+ * 
+ * @details - Waits out tRS (80us) since the last resume, then up to tSUS (100us)
+ *            for the device to stop
+ *          - Chip erase cannot be suspended
+ *          - While suspended only reads are accepted; the page or erase unit
+ *            being changed must not be read (undefined data)
+ *          - IS25LP_AsyncTick() does nothing until IS25LP_Resume()
+ *          - With read_suspend set in the handle, IS25LP_Read()/IS25LP_FastRead()
+ *            do this automatically around reads outside the busy unit
+ */
+eIS25LP_Status_t IS25LP_Suspend(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Resume a program or erase stopped by IS25LP_Suspend (0x7A command)
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details The suspended time is not counted against the operation timeout.
+ */
+eIS25LP_Status_t IS25LP_Resume(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Configure how the driver waits for an operation to finish
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  op: Operation class the policy applies to
+ * @param  mode: Polling method
+ * @param  interval_us: Delay between status reads for IS25LP_POLL_BACKOFF_US
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ * 
+ * @details Defaults after IS25LP_Init():
+ *          - Read check:    back-off 0us (tight polling)
+ *          - Page program:  continuous RDSR under one CS assertion
+ *          - Sector erase:  back-off 1000us
+ *          - Block erase:   back-off 2000us
+ *          - Chip erase:    1ms delay
+ */
+eIS25LP_Status_t IS25LP_SetPollPolicy(sIS25LP_Handle_t *handle, eIS25LP_Operation_t op, eIS25LP_PollMode_t mode, uint32_t interval_us);
+
+/**
+ * @brief  Get the learned busy-time statistics of an operation class
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  op: Operation class (page program or one of the erases)
+ * @param  stats: Pointer to structure to receive the statistics
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ * 
+ * @details A rising avg_us/max_us for erases over the device lifetime
+ *          indicates wear; last_address identifies the unit measured last.
+ */
+eIS25LP_Status_t IS25LP_GetTimingStats(sIS25LP_Handle_t *handle, eIS25LP_Operation_t op, sIS25LP_TimingStats_t *stats);
+
+/**
+ * @brief  Forget all learned busy-time statistics
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ */
+eIS25LP_Status_t IS25LP_ResetTimingStats(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Copy the instrumentation counters of a handle
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  snapshot: Pointer to structure to receive the counters
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters or
+ *         when built with IS25LP_USE_STATS = 0
+ * 
+ * @details Transfer time (sum of opcode[].time_us) against wait time
+ *          (sum of wait[].time_us) shows where flash time goes. DMA
+ *          completions update the counters from interrupt context, take
+ *          the snapshot while IS25LP_IsTransferBusy() is false for
+ *          consistent values.
+ */
+eIS25LP_Status_t IS25LP_GetStats(sIS25LP_Handle_t *handle, sIS25LP_Stats_t *snapshot);
+
+/**
+ * @brief  Clear the instrumentation counters of a handle
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters or
+ *         when built with IS25LP_USE_STATS = 0
+ */
+eIS25LP_Status_t IS25LP_ResetStats(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Start or stop recording bus transactions into the trace ring
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  enable: true to record, false to freeze the ring (e.g. after a latency spike)
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters or
+ *         when built with IS25LP_TRACE_ENTRIES = 0
+ * 
+ * @details Recording is on after IS25LP_Init(). A transaction already
+ *          running when recording stops is still completed.
+ */
+eIS25LP_Status_t IS25LP_TraceEnable(sIS25LP_Handle_t *handle, bool enable);
+
+/**
+ * @brief  Discard all trace records
+ * @param  handle: Pointer to IS25LP handle structure
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters, while
+ *         a transaction is being recorded, or when built with
+ *         IS25LP_TRACE_ENTRIES = 0
+ */
+eIS25LP_Status_t IS25LP_TraceClear(sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Microsecond time base used for polling and timing
+ * @retval Free-running microsecond counter (wraps after ~71 minutes)
+ * 
+ * @details Default implementation interpolates SysTick between 1ms HAL
+ *          ticks and counts a tick still pending (PENDSTSET), so it stays
+ *          monotonic in interrupts above SysTick priority. Declared weak,
+ *          override it with a hardware timer for better resolution or when
+ *          SysTick is not running at 1kHz.
+ */
+uint32_t IS25LP_GetMicros(void);
+
 #endif /* INC_IS25LP040E_H_ */
@@ -0,0 +1,115 @@
+/**
+ * @file    is25lp040e_bench.h
+ * @brief   Header file for IS25LP040E driver benchmarks.
+ *          Measures driver latency on the target using IS25LP_GetMicros().
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef INC_IS25LP040E_BENCH_H_
+#define INC_IS25LP040E_BENCH_H_
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e.h"
+
+/**
+ * @struct sIS25LP_BenchSmallRead_t
+ * @brief Result of the small random read latency benchmark
+ */
+typedef struct
+{
+    uint32_t length;            // Read length in bytes
+    uint32_t iterations;        // Reads per variant
+    uint32_t polled_avg_us;     // Average latency with a status poll before every read
+    uint32_t idle_avg_us;       // Average latency with device idle tracking
+} sIS25LP_BenchSmallRead_t;
+
+/**
+ * @brief  Measure small random read latency with and without idle tracking
+ * @param  handle: Pointer to initialized IS25LP handle structure
+ * @param  length: Read length in bytes (1-256, typ. 16-64)
+ * @param  iterations: Number of reads per variant
+ * @param  result: Pointer to structure to receive the averages
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details - Reads the same pseudo-random addresses twice with IS25LP_Read:
+ *            once with device_idle cleared before every read (RDSR poll
+ *            each time, behaviour before idle tracking) and once with
+ *            idle tracking active
+ *          - Non-destructive, only reads the array
+ */
+eIS25LP_Status_t IS25LP_Bench_SmallReadLatency(sIS25LP_Handle_t *handle, uint32_t length, uint32_t iterations, sIS25LP_BenchSmallRead_t *result);
+
+/**
+ * @struct sIS25LP_BenchEraseRange_t
+ * @brief Result of the range erase benchmark
+ */
+typedef struct
+{
+    uint32_t start;             // Start address of the range
+    uint32_t length;            // Range length in bytes
+    uint32_t naive_us;          // Time for one IS25LP_EraseSector per 4KB
+    uint32_t planned_us;        // Time for IS25LP_EraseRange
+} sIS25LP_BenchEraseRange_t;
+
+/**
+ * @brief  Compare IS25LP_EraseRange against a per-sector erase loop
+ * @param  handle: Pointer to initialized IS25LP handle structure
+ * @param  start: Start address (4KB aligned)
+ * @param  length: Range length (multiple of 4KB)
+ * @param  result: Pointer to structure to receive the timings
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details - Erases the range twice: sector by sector, then planned
+ * @warning Destructive, the range is erased
+ */
+eIS25LP_Status_t IS25LP_Bench_EraseRange(sIS25LP_Handle_t *handle, uint32_t start, uint32_t length, sIS25LP_BenchEraseRange_t *result);
+
+#ifndef IS25LP_BENCH_MAX_SAMPLES
+#define IS25LP_BENCH_MAX_SAMPLES    64       // Iterations per suite case (latency samples kept for percentiles)
+#endif
+
+/**
+ * @brief Receives one CSV line of the benchmark suite (no line terminator)
+ * @param line: Zero-terminated text
+ * @param context: User pointer passed to IS25LP_Bench_Suite
+ */
+typedef void ( *IS25LP_BenchEmit_t )( const char *line, void *context );
+
+/**
+ * @struct sIS25LP_BenchSuite_t
+ * @brief Benchmark suite configuration
+ */
+typedef struct
+{
+    uint32_t region_start;      // Scratch area, 64KB aligned
+    uint32_t region_length;     // Multiple of 64KB, at least 64KB
+    uint32_t iterations;        // Operations per case (max IS25LP_BENCH_MAX_SAMPLES)
+    bool chip_erase;            // Also time IS25LP_EraseChip (erases everything)
+} sIS25LP_BenchSuite_t;
+
+/**
+ * @brief  Run the throughput/latency suite and emit CSV
+ * @param  handle: Pointer to initialized IS25LP handle structure
+ * @param  config: Scratch region and iteration count
+ * @param  emit: Line sink (UART, semihosting, stdout on the host)
+ * @param  context: User pointer passed to emit
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters or driver failure
+ * 
+ * @details - Columns: op,pattern,size,align,iterations,mb_s,p50_us,p99_us,bus_pct
+ *          - Read and FastRead: 1B-4KB, page aligned and +1 byte
+ *          - WritePage: 1-256B, Write: 16B-4KB (region erased before each case)
+ *          - Patterns: sequential, random (page granular), strided (4KB)
+ *          - Erases: sector, 32KB and 64KB units of the region, sequential
+ *          - bus_pct: wire time of command + payload over elapsed time
+ *          - Timed with IS25LP_GetMicros(), override it with a free-running
+ *            1MHz hardware timer for sub-millisecond accuracy on target
+ * @warning Destructive, the region (and with chip_erase the device) is erased
+ */
+eIS25LP_Status_t IS25LP_Bench_Suite(sIS25LP_Handle_t *handle, const sIS25LP_BenchSuite_t *config, IS25LP_BenchEmit_t emit, void *context);
+
+#endif /* INC_IS25LP040E_BENCH_H_ */
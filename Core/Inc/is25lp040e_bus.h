@@ -0,0 +1,168 @@
+/**
+ * @file    is25lp040e_bus.h
+ * @brief   Header file for the IS25LP040E multi-chip bus manager.
+ *          Several chips on one SPI, striped into one address space.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ *
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef INC_IS25LP040E_BUS_H_
+#define INC_IS25LP040E_BUS_H_
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e.h"
+
+#ifndef IS25LP_BUS_MAX_CHIPS
+#define IS25LP_BUS_MAX_CHIPS        4        // Chips sharing one SPI (at most IS25LP_MAX_INSTANCES)
+#endif
+
+#ifndef IS25LP_BUS_STRIPE_SIZE
+#define IS25LP_BUS_STRIPE_SIZE      IS25LP_SECTOR_SIZE  // Interleave unit, consecutive stripes go to consecutive chips
+#endif
+
+#if (( IS25LP_BUS_STRIPE_SIZE % IS25LP_SECTOR_SIZE ) != 0 ) || (( IS25LP_CHIP_SIZE % IS25LP_BUS_STRIPE_SIZE ) != 0 )
+#error "IS25LP_BUS_STRIPE_SIZE must be a multiple of the sector size dividing the chip size"
+#endif
+
+struct sIS25LP_Bus;
+
+/**
+ * @brief Completion callback for bus operations
+ * @param bus: Bus the operation ran on
+ * @param status: IS25LP_OK if every chip succeeded, IS25LP_ERROR otherwise
+ * @param context: User pointer passed when the operation was started
+ */
+typedef void ( *IS25LP_BusCallback_t )( struct sIS25LP_Bus *bus, eIS25LP_Status_t status, void *context );
+
+/**
+ * @struct sIS25LP_BusJob_t
+ * @brief Share of the running bus operation on one chip (managed by the bus)
+ */
+typedef struct
+{
+    uint32_t next;              // Write: bus address of the next stripe piece, erase: next chip address
+    uint32_t end;               // Write: end of the request (bus address), erase: end of the chip range
+    bool running;               // Chip still has work for the operation
+} sIS25LP_BusJob_t;
+
+/**
+ * @struct sIS25LP_Bus_t
+ * @brief Chips on one SPI peripheral (set up by IS25LP_BusInit/IS25LP_BusAttach)
+ */
+typedef struct sIS25LP_Bus
+{
+    SPI_HandleTypeDef *spi_handle;                  // SPI shared by all chips
+    sIS25LP_Handle_t *chips[ IS25LP_BUS_MAX_CHIPS ];// Attached chips, index = position in the stripe order
+    uint8_t count;                                  // Number of attached chips
+    uint8_t next_tick;                              // Chip ticked first next time (round robin)
+    bool erase;                                     // Running operation is an erase
+    const uint8_t *source;                          // Program data of the running write
+    uint32_t start;                                 // Bus address the running write starts at
+    sIS25LP_BusJob_t jobs[ IS25LP_BUS_MAX_CHIPS ];  // Per-chip share of the running operation
+    uint8_t pending;                                // Chips still working on it
+    eIS25LP_Status_t status;                        // Combined result so far
+    IS25LP_BusCallback_t callback;                  // Completion callback (may be NULL)
+    void *context;                                  // User pointer for the callback
+} sIS25LP_Bus_t;
+
+/**
+ * @brief  Set up a bus for one SPI peripheral
+ * @param  bus: Bus state
+ * @param  spi_handle: SPI all chips are wired to (CubeMX handle)
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ */
+eIS25LP_Status_t IS25LP_BusInit(sIS25LP_Bus_t *bus, SPI_HandleTypeDef *spi_handle);
+
+/**
+ * @brief  Add a chip to the bus and initialize it
+ * @param  bus: Bus state
+ * @param  handle: Chip handle with cs_gpio (and wp_gpio) filled in
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters,
+ *         a full bus or a failed IS25LP_Init()
+ *
+ * @details Sets spi_handle and shared_spi and calls IS25LP_Init(). Each
+ *          chip needs its own GPIO chip select (IS25LP_CS_GPIO), keep all
+ *          CS pins high before the first chip is attached. The order of
+ *          attaching defines the stripe order, attach every chip before
+ *          storing data. IS25LP_CalibrateClock() may be run per chip.
+ */
+eIS25LP_Status_t IS25LP_BusAttach(sIS25LP_Bus_t *bus, sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Size of the striped address space
+ * @param  bus: Bus state
+ * @retval Number of chips times IS25LP_CHIP_SIZE
+ */
+uint32_t IS25LP_BusSize(sIS25LP_Bus_t *bus);
+
+/**
+ * @brief  Read from the striped address space (blocking)
+ * @param  bus: Bus state
+ * @param  address: Bus start address
+ * @param  buffer: Pointer to buffer for read data
+ * @param  length: Number of bytes to read
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ *
+ * @details Each stripe is read with IS25LP_FastRead() from its chip. A
+ *          chip busy with a background program/erase is read by
+ *          suspending it if its read_suspend is set, otherwise the read
+ *          fails and can be retried once IS25LP_BusIsBusy() is false.
+ */
+eIS25LP_Status_t IS25LP_BusRead(sIS25LP_Bus_t *bus, uint32_t address, uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief  Program a range of the striped address space in the background
+ * @param  bus: Bus state
+ * @param  address: Bus start address
+ * @param  buffer: Data to program, must stay valid until the callback
+ * @param  length: Number of bytes to program
+ * @param  callback: Called once every chip has finished (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if started, IS25LP_ERROR on invalid parameters or
+ *         while a bus operation is running
+ *
+ * @details Every chip programs its stripes with IS25LP_WriteAsync() at the
+ *          same time, so the busy times (tPP) of the chips overlap and the
+ *          throughput grows with the number of chips. Call IS25LP_BusTick()
+ *          periodically. The range must be erased.
+ */
+eIS25LP_Status_t IS25LP_BusWrite(sIS25LP_Bus_t *bus, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_BusCallback_t callback, void *context);
+
+/**
+ * @brief  Erase a range of the striped address space in the background
+ * @param  bus: Bus state
+ * @param  address: Bus start address, aligned to IS25LP_BUS_STRIPE_SIZE
+ * @param  length: Number of bytes, multiple of IS25LP_BUS_STRIPE_SIZE
+ * @param  callback: Called once every chip has finished (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if started, IS25LP_ERROR on invalid parameters or
+ *         while a bus operation is running
+ *
+ * @details The share of each chip is one contiguous range of that chip,
+ *          erased with the largest aligned units (64KB, 32KB, 4KB) while
+ *          the other chips erase theirs. Call IS25LP_BusTick() periodically.
+ */
+eIS25LP_Status_t IS25LP_BusErase(sIS25LP_Bus_t *bus, uint32_t address, uint32_t length, IS25LP_BusCallback_t callback, void *context);
+
+/**
+ * @brief  Advance the background operations of all chips
+ * @param  bus: Bus state
+ *
+ * @details Calls IS25LP_AsyncTick() for every chip, starting with a
+ *          different chip each time. Use it instead of per-chip ticks,
+ *          from thread context only (see IS25LP_AsyncTick).
+ */
+void IS25LP_BusTick(sIS25LP_Bus_t *bus);
+
+/**
+ * @brief  Check for a running bus operation
+ * @param  bus: Bus state
+ * @retval true while an IS25LP_BusWrite/IS25LP_BusErase is in progress
+ */
+bool IS25LP_BusIsBusy(sIS25LP_Bus_t *bus);
+
+#endif /* INC_IS25LP040E_BUS_H_ */
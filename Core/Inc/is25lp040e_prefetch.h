@@ -0,0 +1,90 @@
+/**
+ * @file    is25lp040e_prefetch.h
+ * @brief   Header file for the IS25LP040E read-ahead layer.
+ *          Detects sequential reads and prefetches the next window via DMA.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef INC_IS25LP040E_PREFETCH_H_
+#define INC_IS25LP040E_PREFETCH_H_
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e.h"
+
+#ifndef IS25LP_PREFETCH_TRIGGER
+#define IS25LP_PREFETCH_TRIGGER     2        // Back-to-back sequential reads before read-ahead starts
+#endif
+
+#define IS25LP_PREFETCH_INVALID     0xFFFFFFFFUL    // Window holds no data
+
+/**
+ * @struct sIS25LP_PrefetchStats_t
+ * @brief Read-ahead counters
+ */
+typedef struct
+{
+    uint32_t hits;              // Reads served from a completed window
+    uint32_t waits;             // Reads that had to wait for the running prefetch
+    uint32_t misses;            // Reads that went to the bus synchronously
+} sIS25LP_PrefetchStats_t;
+
+/**
+ * @struct sIS25LP_Prefetch_t
+ * @brief One read-ahead stream (set up by IS25LP_PrefetchInit)
+ */
+typedef struct
+{
+    sIS25LP_Handle_t *handle;           // Flash the stream reads from
+    uint8_t *buffer[ 2 ];               // Window buffers, used alternately
+    uint32_t window_size;               // Size of each buffer in bytes
+    uint32_t address[ 2 ];              // Flash address of each window, IS25LP_PREFETCH_INVALID if empty
+    uint32_t length[ 2 ];               // Valid bytes in each window
+    uint8_t current;                    // Window reads are served from
+    bool inflight;                      // DMA is filling the other window
+    sIS25LP_TransferResult_t result;    // Outcome of that DMA, filled in by the driver
+    uint32_t next;                      // Address a sequential read would start at
+    uint32_t sequential;                // Consecutive sequential reads
+    uint32_t modify_count;              // handle->modify_count the windows belong to
+    sIS25LP_PrefetchStats_t stats;      // Counters
+} sIS25LP_Prefetch_t;
+
+/**
+ * @brief  Set up a read-ahead stream
+ * @param  prefetch: Stream state
+ * @param  handle: Pointer to initialized IS25LP handle structure (DMA linked)
+ * @param  buffer0: First window buffer
+ * @param  buffer1: Second window buffer
+ * @param  window_size: Size of each buffer in bytes
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ */
+eIS25LP_Status_t IS25LP_PrefetchInit(sIS25LP_Prefetch_t *prefetch, sIS25LP_Handle_t *handle, uint8_t *buffer0, uint8_t *buffer1, uint32_t window_size);
+
+/**
+ * @brief  Read through the read-ahead stream
+ * @param  prefetch: Stream state
+ * @param  address: Start address
+ * @param  buffer: Pointer to buffer for read data
+ * @param  length: Number of bytes to read
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details - After IS25LP_PREFETCH_TRIGGER back-to-back sequential reads the
+ *            stream keeps a Fast Read DMA of the following window running
+ *          - Reads inside a prefetched window are plain memory copies
+ *          - Random reads bypass the windows
+ *          - Windows are dropped when the driver programs or erases anything
+ */
+eIS25LP_Status_t IS25LP_PrefetchRead(sIS25LP_Prefetch_t *prefetch, uint32_t address, uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief  Stop read-ahead and drop the windows
+ * @param  prefetch: Stream state
+ * @retval IS25LP_OK on success, IS25LP_ERROR if the running prefetch failed
+ */
+eIS25LP_Status_t IS25LP_PrefetchReset(sIS25LP_Prefetch_t *prefetch);
+
+#endif /* INC_IS25LP040E_PREFETCH_H_ */
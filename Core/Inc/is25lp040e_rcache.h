@@ -0,0 +1,121 @@
+/**
+ * @file    is25lp040e_rcache.h
+ * @brief   Header file for the IS25LP040E read cache.
+ *          LRU/CLOCK line cache on top of an IS25LP handle.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef INC_IS25LP040E_RCACHE_H_
+#define INC_IS25LP040E_RCACHE_H_
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e.h"
+
+#define IS25LP_RCACHE_INVALID       0xFFFFFFFFUL    // Unused line
+
+/**
+ * @enum eIS25LP_RCachePolicy_t
+ * @brief Replacement policy of the read cache
+ */
+typedef enum
+{
+    IS25LP_RCACHE_LRU = 0,      // Evict the least recently used line
+    IS25LP_RCACHE_CLOCK         // Second-chance clock, cheaper bookkeeping per hit
+} eIS25LP_RCachePolicy_t;
+
+/**
+ * @struct sIS25LP_RCacheStats_t
+ * @brief Read cache counters
+ */
+typedef struct
+{
+    uint32_t hits;              // Line lookups served from RAM
+    uint32_t misses;            // Line lookups that went to the bus
+    uint32_t evictions;         // Valid lines replaced by a miss
+    uint32_t invalidations;     // Lines dropped by writes/erases
+} sIS25LP_RCacheStats_t;
+
+/**
+ * @struct sIS25LP_RCacheTag_t
+ * @brief Bookkeeping of one cache line (stored at the start of the arena)
+ */
+typedef struct
+{
+    uint32_t address;           // Line address, IS25LP_RCACHE_INVALID if unused
+    uint32_t stamp;             // LRU: last use, CLOCK: reference bit
+} sIS25LP_RCacheTag_t;
+
+/**
+ * @struct sIS25LP_ReadCache_t
+ * @brief Read cache state (set up by IS25LP_ReadCacheInit)
+ */
+typedef struct sIS25LP_ReadCache
+{
+    sIS25LP_RCacheTag_t *tags;          // One tag per line
+    uint8_t *data;                      // lines * line_size bytes
+    uint32_t lines;                     // Number of lines fitting the arena
+    uint32_t line_size;                 // 256 or 4096 bytes
+    eIS25LP_RCachePolicy_t policy;      // Replacement policy
+    uint32_t now;                       // LRU use counter
+    uint32_t hand;                      // CLOCK hand
+    sIS25LP_RCacheStats_t stats;        // Counters
+} sIS25LP_ReadCache_t;
+
+/**
+ * @brief  Attach a read cache to a handle
+ * @param  handle: Pointer to initialized IS25LP handle structure
+ * @param  cache: Cache state (must stay valid while attached)
+ * @param  arena: RAM for tags and line data
+ * @param  arena_size: Size of the arena in bytes
+ * @param  line_size: IS25LP_PAGE_SIZE or IS25LP_SECTOR_SIZE
+ * @param  policy: Replacement policy
+ * @retval IS25LP_OK on success, IS25LP_ERROR if not even one line fits
+ * 
+ * @details Each line costs line_size + 8 bytes of arena. Writes and erases
+ *          through the driver invalidate overlapping lines automatically.
+ */
+eIS25LP_Status_t IS25LP_ReadCacheInit(sIS25LP_Handle_t *handle, sIS25LP_ReadCache_t *cache, void *arena, uint32_t arena_size, uint32_t line_size, eIS25LP_RCachePolicy_t policy);
+
+/**
+ * @brief  Read through the cache
+ * @param  handle: Pointer to IS25LP handle structure with a cache attached
+ * @param  address: Start address
+ * @param  buffer: Pointer to buffer for read data
+ * @param  length: Number of bytes to read
+ * @retval IS25LP_OK on success, IS25LP_ERROR on failure
+ * 
+ * @details Missing lines are filled with one Fast Read (0x0B) each.
+ */
+eIS25LP_Status_t IS25LP_CachedRead(sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief  Drop cached lines overlapping a range
+ * @param  handle: Pointer to IS25LP handle structure
+ * @param  address: Start address
+ * @param  length: Number of bytes
+ * 
+ * @details Called by the driver for every program/erase, no-op without cache.
+ */
+void IS25LP_ReadCacheInvalidate(sIS25LP_Handle_t *handle, uint32_t address, uint32_t length);
+
+/**
+ * @brief  Get the read cache counters
+ * @param  handle: Pointer to IS25LP handle structure with a cache attached
+ * @param  stats: Pointer to structure to receive the counters
+ * @retval IS25LP_OK on success, IS25LP_ERROR without cache
+ */
+eIS25LP_Status_t IS25LP_GetReadCacheStats(sIS25LP_Handle_t *handle, sIS25LP_RCacheStats_t *stats);
+
+/**
+ * @brief  Reset the read cache counters
+ * @param  handle: Pointer to IS25LP handle structure with a cache attached
+ * @retval IS25LP_OK on success, IS25LP_ERROR without cache
+ */
+eIS25LP_Status_t IS25LP_ResetReadCacheStats(sIS25LP_Handle_t *handle);
+
+#endif /* INC_IS25LP040E_RCACHE_H_ */
@@ -0,0 +1,169 @@
+/**
+ * @file    is25lp040e_sched.h
+ * @brief   Header file for the IS25LP040E request scheduler.
+ *          Prioritized read/program/erase queues in front of one handle.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef INC_IS25LP040E_SCHED_H_
+#define INC_IS25LP040E_SCHED_H_
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e.h"
+
+#ifndef IS25LP_SCHED_DEPTH
+#define IS25LP_SCHED_DEPTH          8        // Requests that can be queued at once (static pool)
+#endif
+
+#ifndef IS25LP_SCHED_AGING_MS
+#define IS25LP_SCHED_AGING_MS       50       // Waiting time that raises a request by one priority level (0 = no aging)
+#endif
+
+/**
+ * @enum eIS25LP_ReqClass_t
+ * @brief Request classes, each with its own queue and priority
+ */
+typedef enum
+{
+    IS25LP_REQ_READ = 0,        // Fast Read
+    IS25LP_REQ_PROGRAM,         // Multi-page program (IS25LP_WriteAsync)
+    IS25LP_REQ_ERASE,           // Erase (IS25LP_EraseAsync)
+    IS25LP_REQ_CLASS_COUNT
+} eIS25LP_ReqClass_t;
+
+/**
+ * @struct sIS25LP_Request_t
+ * @brief Queued request (pool entry, managed by the scheduler)
+ */
+typedef struct sIS25LP_Request
+{
+    struct sIS25LP_Request *next;   // Next request in the same queue or the free list
+    eIS25LP_ReqClass_t req_class;   // Queue it belongs to
+    uint32_t address;               // Flash address
+    uint8_t *destination;           // Read buffer
+    const uint8_t *source;          // Program data
+    uint32_t length;                // Bytes to read/program
+    eIS25LP_EraseType_t erase_type; // Erase granularity
+    uint32_t enqueue_tick;          // HAL_GetTick() when queued (aging)
+    uint32_t sequence;              // Submission order across all classes
+    IS25LP_Callback_t callback;     // Completion callback (may be NULL)
+    void *context;                  // User pointer for the callback
+} sIS25LP_Request_t;
+
+/**
+ * @struct sIS25LP_SchedStats_t
+ * @brief Scheduler counters
+ */
+typedef struct
+{
+    uint32_t completed[ IS25LP_REQ_CLASS_COUNT ];   // Requests finished per class
+    uint32_t preempted;         // Reads served by suspending a running program/erase
+    uint32_t aged;              // Requests that only won because of aging
+    uint32_t ordered;           // Ticks a request was held back for an older overlapping one
+    uint32_t rejected;          // Submissions refused because the pool was empty
+} sIS25LP_SchedStats_t;
+
+/**
+ * @struct sIS25LP_Scheduler_t
+ * @brief Scheduler state (set up by IS25LP_SchedInit)
+ */
+typedef struct
+{
+    sIS25LP_Handle_t *handle;                           // Flash the requests run on
+    sIS25LP_Request_t pool[ IS25LP_SCHED_DEPTH ];       // Request storage
+    sIS25LP_Request_t *free_list;                       // Unused pool entries
+    sIS25LP_Request_t *head[ IS25LP_REQ_CLASS_COUNT ];  // Oldest request per class
+    sIS25LP_Request_t *tail[ IS25LP_REQ_CLASS_COUNT ];  // Newest request per class
+    uint8_t priority[ IS25LP_REQ_CLASS_COUNT ];         // Base priority per class, 0 = most urgent
+    uint32_t aging_ms;                                  // See IS25LP_SCHED_AGING_MS
+    uint32_t sequence;                                  // Sequence number of the next submission
+    sIS25LP_Request_t *active;                          // Program/erase running on the device
+    sIS25LP_SchedStats_t stats;                         // Counters
+} sIS25LP_Scheduler_t;
+
+/**
+ * @brief  Set up a scheduler for one handle
+ * @param  sched: Scheduler state
+ * @param  handle: Pointer to initialized IS25LP handle structure
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ * 
+ * @details Default priorities: read 0, program 1, erase 2. Set read_suspend
+ *          in the handle to let reads preempt a running program/erase.
+ */
+eIS25LP_Status_t IS25LP_SchedInit(sIS25LP_Scheduler_t *sched, sIS25LP_Handle_t *handle);
+
+/**
+ * @brief  Change the base priority of a request class
+ * @param  sched: Scheduler state
+ * @param  req_class: Class to change
+ * @param  priority: New priority, 0 = most urgent
+ * @retval IS25LP_OK on success, IS25LP_ERROR on invalid parameters
+ */
+eIS25LP_Status_t IS25LP_SchedSetPriority(sIS25LP_Scheduler_t *sched, eIS25LP_ReqClass_t req_class, uint8_t priority);
+
+/**
+ * @brief  Queue a read
+ * @param  sched: Scheduler state
+ * @param  address: Start address
+ * @param  buffer: Pointer to buffer for read data
+ * @param  length: Number of bytes to read
+ * @param  callback: Completion callback (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if queued, IS25LP_ERROR on invalid parameters or full pool
+ */
+eIS25LP_Status_t IS25LP_SchedRead(sIS25LP_Scheduler_t *sched, uint32_t address, uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context);
+
+/**
+ * @brief  Queue a program
+ * @param  sched: Scheduler state
+ * @param  address: Start address
+ * @param  buffer: Data to program, must stay valid until the callback
+ * @param  length: Number of bytes to program
+ * @param  callback: Completion callback (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if queued, IS25LP_ERROR on invalid parameters or full pool
+ */
+eIS25LP_Status_t IS25LP_SchedWrite(sIS25LP_Scheduler_t *sched, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context);
+
+/**
+ * @brief  Queue an erase
+ * @param  sched: Scheduler state
+ * @param  type: Erase granularity
+ * @param  address: Any address inside the unit to erase
+ * @param  callback: Completion callback (may be NULL)
+ * @param  context: User pointer passed to the callback
+ * @retval IS25LP_OK if queued, IS25LP_ERROR on invalid parameters or full pool
+ */
+eIS25LP_Status_t IS25LP_SchedErase(sIS25LP_Scheduler_t *sched, eIS25LP_EraseType_t type, uint32_t address, IS25LP_Callback_t callback, void *context);
+
+/**
+ * @brief  Run the scheduler (call periodically instead of IS25LP_AsyncTick)
+ * @param  sched: Scheduler state
+ * 
+ * @details - Advances the running program/erase
+ *          - Queued reads that outrank it are served right away by
+ *            suspending it (handle->read_suspend)
+ *          - When the device is free, starts the request with the lowest
+ *            priority value; every IS25LP_SCHED_AGING_MS of waiting lowers
+ *            that value by one so no class starves
+ *          - Requests whose ranges overlap an older program/erase (or an
+ *            older read, for programs/erases) keep submission order,
+ *            priority only reorders independent requests
+ *          - Reads run blocking, programs and erases asynchronously
+ *          - Thread context only, like IS25LP_AsyncTick
+ */
+void IS25LP_SchedTick(sIS25LP_Scheduler_t *sched);
+
+/**
+ * @brief  Number of queued or running requests
+ * @param  sched: Scheduler state
+ * @retval Requests not yet completed
+ */
+uint32_t IS25LP_SchedPending(sIS25LP_Scheduler_t *sched);
+
+#endif /* INC_IS25LP040E_SCHED_H_ */
@@ -12,8 +12,12 @@
  * @include necessary headers
  */
 #include "is25lp040e.h"
+#include "is25lp040e_rcache.h"
 #include "main.h"
 #include "spi.h"
+#if IS25LP_USE_LL_SPI
+#include "stm32g0xx_ll_spi.h"
+#endif
 
 #include <string.h>
 
@@ -36,6 +40,9 @@
 #define CMD_READ_UNIQUE_ID      0x4B    // Read Unique ID
 #define CMD_DEEP_POWER_DOWN     0xB9    // Deep Power-Down
 #define CMD_RELEASE_POWER_DOWN  0xAB    // Release from Deep Power-Down
+#define CMD_SUSPEND             0x75    // Program/Erase Suspend
+#define CMD_RESUME              0x7A    // Program/Erase Resume
+#define CMD_READ_FUNCTION_REG   0x48    // Read Function Register
 
 /**
  * @brief   Status Register Bits
@@ -43,86 +50,2586 @@
 #define STATUS_BUSY             0x01    // Write In Progress (WIP)
 #define STATUS_WEL              0x02    // Write Enable Latch
 
+/**
+ * @brief   Function Register Bits
+ */
+#define FUNCTION_PSUS           0x04    // Program suspended
+#define FUNCTION_ESUS           0x08    // Erase suspended
+
 /**
  * @brief   Timeouts (in milliseconds)
  */
-#define TIMEOUT_SPI             5       // SPI Communication
+#define TIMEOUT_SPI             5       // SPI Communication (fixed overhead per transfer)
 #define TIMEOUT_PAGE_PROGRAM    10      // Page Program (~3ms typ)
 #define TIMEOUT_SECTOR_ERASE    200     // Sector Erase (~100ms typ)
 #define TIMEOUT_BLOCK_ERASE_32K 500     // Block Erase 32KB
 #define TIMEOUT_BLOCK_ERASE_64K 1000    // Block Erase 64KB
 #define TIMEOUT_CHIP_ERASE      10000   // Chip Erase (~3s typ)
+#define TIMEOUT_MARGIN          2       // Factor applied to the computed wire time
+
+/**
+ * @brief   Suspend Timing (microseconds)
+ */
+#define TIME_SUSPEND_US         100     // tSUS, suspend to read-ready (max)
+#define TIME_RESUME_US          80      // tRS, resume to next suspend (min)
+
+/**
+ * @brief   Maximum clock frequencies (Hz)
+ */
+#define FREQ_READ_MAX           50000000    // fC, Normal Read (0x03)
+#define FREQ_FAST_MAX           104000000   // fCT, all other commands
 
 #define DUMMY_BYTE              0xFF
+#define ERASE_SKIP              0xFF    // EraseRange plan entry: blank sector, no erase
+#define DMA_MAX_CHUNK           0xFFFF  // DMA counter (CNDTR) is 16 bit
+#define HAL_MAX_CHUNK           0xFFFF  // HAL blocking transfer size is 16 bit
+#define SPI_FIFO_DEPTH          4       // RX/TX FIFO depth in 8-bit frames
+
+/**
+ * @brief   Handles registered for DMA callback dispatch
+ */
+static sIS25LP_Handle_t *s_instances[ IS25LP_MAX_INSTANCES ];
+
+/**
+ * @brief   Dummy byte clocked out by the TX DMA channel during reads
+ */
+static const uint8_t s_dummy_tx = DUMMY_BYTE;
+
+/**
+ * @brief   Erase command and operation class per eIS25LP_EraseType_t
+ */
+static const struct
+{
+    uint8_t command;
+    eIS25LP_Operation_t op;
+    uint32_t size;
+} s_erase_ops[] = {
+    [ IS25LP_ERASE_SECTOR ]    = { CMD_SECTOR_ERASE,    IS25LP_OP_SECTOR_ERASE,    IS25LP_SECTOR_SIZE },
+    [ IS25LP_ERASE_BLOCK_32K ] = { CMD_BLOCK_ERASE_32K, IS25LP_OP_BLOCK_ERASE_32K, IS25LP_BLOCK_32K_SIZE },
+    [ IS25LP_ERASE_BLOCK_64K ] = { CMD_BLOCK_ERASE_64K, IS25LP_OP_BLOCK_ERASE_64K, IS25LP_BLOCK_64K_SIZE },
+    [ IS25LP_ERASE_CHIP ]      = { CMD_CHIP_ERASE,      IS25LP_OP_CHIP_ERASE,      IS25LP_CHIP_SIZE }
+};
+
+/**
+ * @brief   Busy-wait timeout per eIS25LP_Operation_t
+ */
+static const uint32_t s_op_timeouts[ IS25LP_OP_COUNT ] = {
+    [ IS25LP_OP_READ ]            = TIMEOUT_SPI,
+    [ IS25LP_OP_PAGE_PROGRAM ]    = TIMEOUT_PAGE_PROGRAM,
+    [ IS25LP_OP_SECTOR_ERASE ]    = TIMEOUT_SECTOR_ERASE,
+    [ IS25LP_OP_BLOCK_ERASE_32K ] = TIMEOUT_BLOCK_ERASE_32K,
+    [ IS25LP_OP_BLOCK_ERASE_64K ] = TIMEOUT_BLOCK_ERASE_64K,
+    [ IS25LP_OP_CHIP_ERASE ]      = TIMEOUT_CHIP_ERASE
+};
+
+/**
+ * @brief   Typical busy time per eIS25LP_Operation_t (datasheet, microseconds)
+ */
+static const uint32_t s_op_typical_us[ IS25LP_OP_COUNT ] = {
+    [ IS25LP_OP_READ ]            = 0,
+    [ IS25LP_OP_PAGE_PROGRAM ]    = 450,
+    [ IS25LP_OP_SECTOR_ERASE ]    = 70000,
+    [ IS25LP_OP_BLOCK_ERASE_32K ] = 130000,
+    [ IS25LP_OP_BLOCK_ERASE_64K ] = 200000,
+    [ IS25LP_OP_CHIP_ERASE ]      = 1500000
+};
+
+/**
+ * @brief   Default polling policy per eIS25LP_Operation_t
+ */
+static const sIS25LP_PollPolicy_t s_default_poll[ IS25LP_OP_COUNT ] = {
+    [ IS25LP_OP_READ ]            = { IS25LP_POLL_BACKOFF_US, 0 },
+    [ IS25LP_OP_PAGE_PROGRAM ]    = { IS25LP_POLL_CONTINUOUS, 0 },
+    [ IS25LP_OP_SECTOR_ERASE ]    = { IS25LP_POLL_BACKOFF_US, 1000 },
+    [ IS25LP_OP_BLOCK_ERASE_32K ] = { IS25LP_POLL_BACKOFF_US, 2000 },
+    [ IS25LP_OP_BLOCK_ERASE_64K ] = { IS25LP_POLL_BACKOFF_US, 2000 },
+    [ IS25LP_OP_CHIP_ERASE ]      = { IS25LP_POLL_DELAY_1MS,  0 }
+};
+
+/**
+ * @brief  Cache the chip select registers of a handle
+ */
+static void SPI_CS_Setup( sIS25LP_Handle_t *handle )
+{
+    if( IS25LP_CS_GPIO != handle->cs_mode )
+    {
+        return;
+    }
+
+    handle->cs.set_reg = &handle->cs_gpio.port->BSRR;
+    handle->cs.reset_reg = &handle->cs_gpio.port->BRR;
+    handle->cs.mask = handle->cs_gpio.pin;
+}
+
+/**
+ * @brief  Switch the SPI clock to the limit of the given command
+ * @note   Only touches CR1 when the prescaler changes, CS is still high here.
+ */
+static inline void IS25LP_ApplyClock( sIS25LP_Handle_t *handle, uint8_t command )
+{
+    uint32_t prescaler = ( CMD_READ_DATA == command ) ? handle->clock.read_prescaler : handle->clock.fast_prescaler;
+
+    if( prescaler != handle->spi_handle->Init.BaudRatePrescaler )
+    {
+        MODIFY_REG( handle->spi_handle->Instance->CR1, SPI_CR1_BR, prescaler );
+        handle->spi_handle->Init.BaudRatePrescaler = prescaler;
+    }
+}
+
+#if IS25LP_USE_STATS
+/**
+ * @brief  Command group of an opcode
+ */
+static uint8_t IS25LP_StatOpcode( uint8_t command )
+{
+    switch( command )
+    {
+        case CMD_READ_DATA:         return IS25LP_STAT_READ;
+        case CMD_FAST_READ:         return IS25LP_STAT_FAST_READ;
+        case CMD_PAGE_PROGRAM:      return IS25LP_STAT_PAGE_PROGRAM;
+        case CMD_SECTOR_ERASE:      return IS25LP_STAT_SECTOR_ERASE;
+        case CMD_BLOCK_ERASE_32K:   return IS25LP_STAT_BLOCK_ERASE_32K;
+        case CMD_BLOCK_ERASE_64K:   return IS25LP_STAT_BLOCK_ERASE_64K;
+        case CMD_CHIP_ERASE:        return IS25LP_STAT_CHIP_ERASE;
+        case CMD_WRITE_ENABLE:      return IS25LP_STAT_WRITE_ENABLE;
+        case CMD_READ_STATUS_REG:   return IS25LP_STAT_READ_STATUS;
+        case CMD_READ_FUNCTION_REG: return IS25LP_STAT_READ_FUNCTION;
+        case CMD_SUSPEND:           return IS25LP_STAT_SUSPEND;
+        case CMD_RESUME:            return IS25LP_STAT_RESUME;
+        case CMD_READ_JEDEC_ID:
+        case CMD_READ_DEVICE_ID:
+        case CMD_READ_UNIQUE_ID:    return IS25LP_STAT_ID;
+        default:                    return IS25LP_STAT_OTHER;
+    }
+}
+
+/**
+ * @brief  Histogram bucket of a duration: 0 for 0us, n for [2^(n-1), 2^n) us
+ */
+static uint32_t IS25LP_StatBucket( uint32_t us )
+{
+    uint32_t bucket = 0;
+
+    while(( us > 0 ) && ( bucket < ( IS25LP_STATS_BUCKETS - 1 )))
+    {
+        us >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+#endif
+
+/**
+ * @brief  Time stamp for the instrumentation, 0 when compiled out
+ */
+static inline uint32_t IS25LP_StatNow( void )
+{
+#if IS25LP_USE_STATS
+    return IS25LP_GetMicros( );
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief  A transaction starts (CS low), open its counters and trace record
+ */
+static inline void IS25LP_TrackOpen( sIS25LP_Handle_t *handle, uint8_t command )
+{
+#if IS25LP_USE_STATS || ( IS25LP_TRACE_ENTRIES > 0 )
+    uint32_t now = IS25LP_GetMicros( );
+#endif
+
+#if IS25LP_USE_STATS
+    handle->stats.open = IS25LP_StatOpcode( command );
+    handle->stats.open_us = now;
+#endif
+
+#if IS25LP_TRACE_ENTRIES > 0
+    if( handle->trace.enabled )
+    {
+        sIS25LP_TraceRecord_t *record = &handle->trace.records[ handle->trace.head % IS25LP_TRACE_ENTRIES ];
+
+        record->start_us = now;
+        record->end_us = now;
+        record->address = IS25LP_TRACE_NO_ADDRESS;
+        record->length = 0;
+        record->opcode = command;
+        record->status = IS25LP_OK;
+        handle->trace.open = true;
+    }
+#endif
+
+    ( void )handle;
+    ( void )command;
+}
+
+/**
+ * @brief  A transaction ends (CS high), account its time and commit the trace record
+ */
+static inline void IS25LP_TrackClose( sIS25LP_Handle_t *handle )
+{
+#if IS25LP_USE_STATS || ( IS25LP_TRACE_ENTRIES > 0 )
+    uint32_t now = IS25LP_GetMicros( );
+#endif
+
+#if IS25LP_USE_STATS
+    if( handle->stats.open < IS25LP_STAT_OPCODE_COUNT )
+    {
+        sIS25LP_OpcodeStats_t *stats = &handle->stats.opcode[ handle->stats.open ];
+        uint32_t elapsed = now - handle->stats.open_us;
+
+        stats->count++;
+        stats->time_us += elapsed;
+        stats->histogram[ IS25LP_StatBucket( elapsed ) ]++;
+        handle->stats.open = IS25LP_STAT_OPCODE_COUNT;
+    }
+#endif
+
+#if IS25LP_TRACE_ENTRIES > 0
+    if( handle->trace.open )
+    {
+        handle->trace.records[ handle->trace.head % IS25LP_TRACE_ENTRIES ].end_us = now;
+        handle->trace.open = false;
+        handle->trace.head++;
+    }
+#endif
+
+    ( void )handle;
+}
+
+/**
+ * @brief  Count the bytes and the outcome of a transfer in the open transaction
+ * @note   tx is the transmitted data if any, the trace takes the address from
+ *         bytes 1-3 of the first transfer (the command header).
+ * @retval status, passed through
+ */
+static inline eIS25LP_Status_t IS25LP_TrackTransfer( sIS25LP_Handle_t *handle, const uint8_t *tx, uint32_t length, eIS25LP_Status_t status )
+{
+#if IS25LP_USE_STATS
+    if( handle->stats.open < IS25LP_STAT_OPCODE_COUNT )
+    {
+        sIS25LP_OpcodeStats_t *stats = &handle->stats.opcode[ handle->stats.open ];
+
+        stats->bytes += length;
+
+        if( IS25LP_OK != status )
+        {
+            stats->errors++;
+        }
+    }
+#endif
+
+#if IS25LP_TRACE_ENTRIES > 0
+    if( handle->trace.open )
+    {
+        sIS25LP_TraceRecord_t *record = &handle->trace.records[ handle->trace.head % IS25LP_TRACE_ENTRIES ];
+
+        if(( 0 == record->length ) && ( NULL != tx ) && ( length >= 4 ))
+        {
+            record->address = (( uint32_t )tx[ 1 ] << 16 ) | (( uint32_t )tx[ 2 ] << 8 ) | tx[ 3 ];
+        }
+
+        // Saturates, 0xFFFF means 64KB or more
+        record->length = (( record->length + length ) > 0xFFFF ) ? 0xFFFF : ( uint16_t )( record->length + length );
+
+        if( IS25LP_OK != status )
+        {
+            record->status = IS25LP_ERROR;
+        }
+    }
+#endif
+
+    ( void )handle;
+    ( void )tx;
+    ( void )length;
+    return status;
+}
+
+/**
+ * @brief  Record a finished ready wait that started at start_us
+ */
+static inline void IS25LP_StatWait( sIS25LP_Handle_t *handle, eIS25LP_Operation_t op, uint32_t start_us, eIS25LP_Status_t status )
+{
+#if IS25LP_USE_STATS
+    sIS25LP_WaitStats_t *stats = &handle->stats.wait[ op ];
+    uint32_t elapsed = IS25LP_GetMicros( ) - start_us;
+
+    stats->count++;
+    stats->time_us += elapsed;
+    stats->histogram[ IS25LP_StatBucket( elapsed ) ]++;
+
+    if( IS25LP_OK != status )
+    {
+        stats->timeouts++;
+    }
+#else
+    ( void )handle;
+    ( void )op;
+    ( void )start_us;
+    ( void )status;
+#endif
+}
+
+/**
+ * @brief  Set the CS-Signal to Low for a command
+ */
+static inline void SPI_CS_Low( sIS25LP_Handle_t *handle, uint8_t command )
+{
+    IS25LP_ApplyClock( handle, command );
+    IS25LP_TrackOpen( handle, command );
+
+    if( IS25LP_CS_HW_NSS == handle->cs_mode )
+    {
+        // NSS output follows SPE
+        __HAL_SPI_ENABLE( handle->spi_handle );
+        return;
+    }
+
+    *handle->cs.reset_reg = handle->cs.mask;
+}
 
 /**
- * @brief  Set the CS-Signal to Low
+ * @brief  Set the CS-Signal to High
+ */
+static inline void SPI_CS_High( sIS25LP_Handle_t *handle )
+{
+    if( IS25LP_CS_HW_NSS == handle->cs_mode )
+    {
+        SPI_TypeDef *spi = handle->spi_handle->Instance;
+
+        // Let the last frame finish shifting before NSS is released
+        while( spi->SR & ( SPI_SR_FTLVL | SPI_SR_BSY ))
+        {
+        }
+        __HAL_SPI_DISABLE( handle->spi_handle );
+    }
+    else
+    {
+        *handle->cs.set_reg = handle->cs.mask;
+    }
+
+    IS25LP_TrackClose( handle );
+}
+
+/**
+ * @brief  Timeout for a transfer of length bytes at the configured SPI clock
+ * @note   Wire time is derived from PCLK and Init.BaudRatePrescaler, doubled
+ *         for margin and added to the fixed TIMEOUT_SPI overhead.
+ */
+uint32_t IS25LP_TransferTimeout( sIS25LP_Handle_t *handle, uint32_t length )
+{
+    // BaudRatePrescaler holds BR[2:0] in CR1 position, divider is 2^(BR+1)
+    uint32_t br = ( handle->spi_handle->Init.BaudRatePrescaler & SPI_CR1_BR ) >> SPI_CR1_BR_Pos;
+    uint32_t spi_hz = HAL_RCC_GetPCLK1Freq( ) >> ( br + 1 );
+    uint64_t wire_ms = ((( uint64_t )length * 8U * 1000U ) + spi_hz - 1 ) / spi_hz;
+
+    return TIMEOUT_SPI + ( uint32_t )( wire_ms * TIMEOUT_MARGIN );
+}
+
+#if IS25LP_USE_LL_SPI
+/**
+ * @brief  Drive a short frame through the SPI FIFO without the HAL state machine
+ * @note   tx == NULL clocks out dummy bytes, rx == NULL discards received bytes.
+ *         Keeps at most SPI_FIFO_DEPTH bytes in flight so the RX FIFO never overruns.
+ */
+static eIS25LP_Status_t IS25LP_LL_Transfer( SPI_TypeDef *spi, const uint8_t *tx, uint8_t *rx, uint16_t length, uint32_t timeout_ms )
+{
+    uint16_t tx_count = 0;
+    uint16_t rx_count = 0;
+    uint32_t tickstart = HAL_GetTick( );
+
+    if( !LL_SPI_IsEnabled( spi ))
+    {
+        LL_SPI_Enable( spi );
+    }
+
+    while( rx_count < length )
+    {
+        uint8_t progress = false;
+
+        if(( tx_count < length ) && (( tx_count - rx_count ) < SPI_FIFO_DEPTH ) && LL_SPI_IsActiveFlag_TXE( spi ))
+        {
+            LL_SPI_TransmitData8( spi, ( NULL != tx ) ? tx[ tx_count ] : DUMMY_BYTE );
+            tx_count++;
+            progress = true;
+        }
+
+        if( LL_SPI_IsActiveFlag_RXNE( spi ))
+        {
+            uint8_t data = LL_SPI_ReceiveData8( spi );
+
+            if( NULL != rx )
+            {
+                rx[ rx_count ] = data;
+            }
+            rx_count++;
+            progress = true;
+        }
+
+        // Only pay for the tick read while the bus is busy shifting
+        if( !progress && (( HAL_GetTick( ) - tickstart ) > timeout_ms ))
+        {
+            return IS25LP_ERROR;
+        }
+    }
+
+    return IS25LP_OK;
+}
+#endif
+
+/**
+ * @brief  Transmit a frame, short frames bypass HAL
+ */
+static eIS25LP_Status_t IS25LP_SPI_Transmit( sIS25LP_Handle_t *handle, const uint8_t *data, uint16_t length )
+{
+#if IS25LP_USE_LL_SPI
+    if( length <= IS25LP_LL_MAX_FRAME )
+    {
+        return IS25LP_TrackTransfer( handle, data, length, IS25LP_LL_Transfer( handle->spi_handle->Instance, data, NULL, length, TIMEOUT_SPI ));
+    }
+#endif
+
+    return IS25LP_TrackTransfer( handle, data, length, ( HAL_OK == HAL_SPI_Transmit( handle->spi_handle, ( uint8_t* )data, length, IS25LP_TransferTimeout( handle, length ))) ? IS25LP_OK : IS25LP_ERROR );
+}
+
+/**
+ * @brief  Full-duplex transfer, short frames bypass HAL
+ */
+static eIS25LP_Status_t IS25LP_SPI_TransmitReceive( sIS25LP_Handle_t *handle, const uint8_t *tx, uint8_t *rx, uint16_t length )
+{
+#if IS25LP_USE_LL_SPI
+    if( length <= IS25LP_LL_MAX_FRAME )
+    {
+        return IS25LP_TrackTransfer( handle, NULL, length, IS25LP_LL_Transfer( handle->spi_handle->Instance, tx, rx, length, TIMEOUT_SPI ));
+    }
+#endif
+
+    return IS25LP_TrackTransfer( handle, NULL, length, ( HAL_OK == HAL_SPI_TransmitReceive( handle->spi_handle, ( uint8_t* )tx, rx, length, IS25LP_TransferTimeout( handle, length ))) ? IS25LP_OK : IS25LP_ERROR );
+}
+
+/**
+ * @brief  Receive a payload, short payloads bypass HAL, long ones are chunked
+ */
+static eIS25LP_Status_t IS25LP_SPI_Receive( sIS25LP_Handle_t *handle, uint8_t *rx, uint32_t length )
+{
+#if IS25LP_USE_LL_SPI
+    if( length <= IS25LP_LL_MAX_FRAME )
+    {
+        return IS25LP_TrackTransfer( handle, NULL, length, IS25LP_LL_Transfer( handle->spi_handle->Instance, NULL, rx, ( uint16_t )length, TIMEOUT_SPI ));
+    }
+#endif
+
+    while( length > 0 )
+    {
+        uint16_t chunk = ( length > HAL_MAX_CHUNK ) ? HAL_MAX_CHUNK : ( uint16_t )length;
+
+        if( IS25LP_OK != IS25LP_TrackTransfer( handle, NULL, chunk, ( HAL_OK == HAL_SPI_Receive( handle->spi_handle, rx, chunk, IS25LP_TransferTimeout( handle, chunk ))) ? IS25LP_OK : IS25LP_ERROR ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        rx += chunk;
+        length -= chunk;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Write Enable command
+ */
+static eIS25LP_Status_t IS25LP_WriteEnable( sIS25LP_Handle_t *handle )
+{
+    uint8_t cmd = CMD_WRITE_ENABLE;
+
+    SPI_CS_Low( handle, CMD_WRITE_ENABLE );
+    eIS25LP_Status_t status = IS25LP_SPI_Transmit( handle, &cmd, sizeof(cmd) );
+    SPI_CS_High( handle );
+
+    return status;
+}
+
+/**
+ * @brief  Read Status Register
+ */
+static uint8_t IS25LP_ReadStatusRegister( sIS25LP_Handle_t *handle )
+{
+    uint8_t cmd[2] = { CMD_READ_STATUS_REG, DUMMY_BYTE };
+    uint8_t response[ 2 ];
+
+    SPI_CS_Low( handle, CMD_READ_STATUS_REG );
+    IS25LP_SPI_TransmitReceive( handle, cmd, response, sizeof(cmd) );
+    SPI_CS_High( handle );
+
+    return response[ 1 ];
+}
+
+/**
+ * @brief  Read Function Register
+ */
+static uint8_t IS25LP_ReadFunctionRegister( sIS25LP_Handle_t *handle )
+{
+    uint8_t cmd[2] = { CMD_READ_FUNCTION_REG, DUMMY_BYTE };
+    uint8_t response[ 2 ];
+
+    SPI_CS_Low( handle, CMD_READ_FUNCTION_REG );
+    IS25LP_SPI_TransmitReceive( handle, cmd, response, sizeof(cmd) );
+    SPI_CS_High( handle );
+
+    return response[ 1 ];
+}
+
+/**
+ * @brief  Remember which operation was just issued (starts its busy time)
+ */
+static void IS25LP_MarkIssued( sIS25LP_Handle_t *handle, eIS25LP_Operation_t op, uint32_t address )
+{
+    handle->device_idle = false;
+    handle->timing.pending_op = op;
+    handle->timing.issue_us = IS25LP_GetMicros( );
+    handle->timing.issue_address = address;
+}
+
+/**
+ * @brief  Busy time after which polling of the pending operation starts
  */
-static void SPI_CS_Low( sIS25LP_Handle_t *handle )
+static uint32_t IS25LP_PredictReadyUs( sIS25LP_Handle_t *handle )
 {
-	HAL_GPIO_WritePin( handle->cs_gpio.port, handle->cs_gpio.pin, GPIO_PIN_RESET );
+#if IS25LP_USE_PREDICTOR
+    if( handle->timing.pending_op >= IS25LP_OP_COUNT )
+    {
+        return 0;
+    }
+
+    const sIS25LP_TimingStats_t *stats = &handle->timing.stats[ handle->timing.pending_op ];
+
+    if( stats->count < IS25LP_PREDICTOR_WARMUP )
+    {
+        return 0;
+    }
+
+    // Wake up two deviations early, never later than the fastest run seen
+    uint32_t margin = 2 * stats->dev_us;
+    uint32_t target = ( stats->avg_us > margin ) ? ( stats->avg_us - margin ) : 0;
+
+    return ( target < stats->min_us ) ? target : stats->min_us;
+#else
+    ( void )handle;
+    return 0;
+#endif
 }
 
-/**
- * @brief  Set the CS-Signal to High
- */
-static void SPI_CS_High( sIS25LP_Handle_t *handle )
-{
-	HAL_GPIO_WritePin( handle->cs_gpio.port, handle->cs_gpio.pin, GPIO_PIN_SET );
+/**
+ * @brief  Update the busy-time model with the completed pending operation
+ */
+static void IS25LP_RecordCompletion( sIS25LP_Handle_t *handle )
+{
+    if( handle->timing.pending_op >= IS25LP_OP_COUNT )
+    {
+        return;
+    }
+
+    sIS25LP_TimingStats_t *stats = &handle->timing.stats[ handle->timing.pending_op ];
+    uint32_t elapsed = IS25LP_GetMicros( ) - handle->timing.issue_us;
+
+    if( 0 == stats->count )
+    {
+        stats->min_us = elapsed;
+        stats->max_us = elapsed;
+        stats->avg_us = elapsed;
+        stats->dev_us = elapsed / 2;
+    }
+    else
+    {
+        int32_t error = ( int32_t )elapsed - ( int32_t )stats->avg_us;
+        int32_t abs_error = ( error < 0 ) ? -error : error;
+
+        stats->avg_us = ( uint32_t )(( int32_t )stats->avg_us + ( error / 8 ));
+        stats->dev_us = ( uint32_t )(( int32_t )stats->dev_us + (( abs_error - ( int32_t )stats->dev_us ) / 4 ));
+
+        if( elapsed < stats->min_us )
+        {
+            stats->min_us = elapsed;
+        }
+        if( elapsed > stats->max_us )
+        {
+            stats->max_us = elapsed;
+        }
+    }
+
+    stats->last_us = elapsed;
+    stats->last_address = handle->timing.issue_address;
+    stats->count++;
+
+    handle->timing.pending_op = IS25LP_OP_COUNT;
+}
+
+/**
+ * @brief  Busy-wait for a number of microseconds
+ */
+static void IS25LP_DelayUs( uint32_t us )
+{
+    uint32_t start = IS25LP_GetMicros( );
+
+    while(( IS25LP_GetMicros( ) - start ) < us )
+    {
+    }
+}
+
+/**
+ * @brief  Poll WIP with one RDSR command while CS stays low
+ */
+static eIS25LP_Status_t IS25LP_PollContinuous( sIS25LP_Handle_t *handle, uint32_t timeout_ms )
+{
+    uint8_t cmd = CMD_READ_STATUS_REG;
+    uint8_t dummy = DUMMY_BYTE;
+    uint8_t status;
+    eIS25LP_Status_t result = IS25LP_ERROR;
+    uint32_t tickstart = HAL_GetTick( );
+
+    SPI_CS_Low( handle, CMD_READ_STATUS_REG );
+
+    if( IS25LP_OK == IS25LP_SPI_Transmit( handle, &cmd, sizeof(cmd) ))
+    {
+        // The status register is shifted out repeatedly until CS goes high
+        while( IS25LP_OK == IS25LP_SPI_TransmitReceive( handle, &dummy, &status, sizeof(status) ))
+        {
+            if( 0 == ( status & STATUS_BUSY ))
+            {
+                result = IS25LP_OK;
+                break;
+            }
+
+            if(( HAL_GetTick( ) - tickstart ) > timeout_ms )
+            {
+                break;
+            }
+        }
+    }
+
+    SPI_CS_High( handle );
+
+    return result;
+}
+
+/**
+ * @brief  Find the handle owning the running transfer on an SPI bus
+ */
+static sIS25LP_Handle_t *IS25LP_FindTransferOwner( SPI_HandleTypeDef *hspi )
+{
+    for( uint32_t i = 0; i < IS25LP_MAX_INSTANCES; i++ )
+    {
+        sIS25LP_Handle_t *handle = s_instances[ i ];
+
+        if(( NULL != handle ) && ( hspi == handle->spi_handle ) && handle->xfer.busy )
+        {
+            return handle;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief  Handle whose DMA read holds the SPI, NULL if the bus is free
+ * @note   On a shared SPI this may be another chip.
+ */
+static sIS25LP_Handle_t *IS25LP_TransferOwner( sIS25LP_Handle_t *handle )
+{
+    if( handle->shared_spi )
+    {
+        return IS25LP_FindTransferOwner( handle->spi_handle );
+    }
+
+    return handle->xfer.busy ? handle : NULL;
+}
+
+/**
+ * @brief  Let a background DMA read (e.g. a prefetch) finish before using the bus
+ */
+static eIS25LP_Status_t IS25LP_DrainTransfer( sIS25LP_Handle_t *handle )
+{
+    sIS25LP_Handle_t *owner = IS25LP_TransferOwner( handle );
+
+    if( NULL == owner )
+    {
+        return IS25LP_OK;
+    }
+
+    eIS25LP_Status_t status = IS25LP_WaitTransfer( owner, IS25LP_TransferTimeout( owner, owner->xfer.remaining + DMA_MAX_CHUNK ));
+
+    // A failed read of another chip is reported to its own caller
+    return (( owner == handle ) || owner->xfer.busy ) ? status : IS25LP_OK;
+}
+
+/**
+ * @brief  Wait until Flash is ready (WIP Bit = 0)
+ */
+static eIS25LP_Status_t IS25LP_WaitForReady( sIS25LP_Handle_t *handle, eIS25LP_Operation_t op )
+{
+    // The bus may still be busy with a background read
+    if( IS25LP_OK != IS25LP_DrainTransfer( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Nothing issued since the last successful wait: skip the RDSR transaction
+    if( handle->device_idle )
+    {
+#if IS25LP_USE_STATS
+        handle->stats.wait[ op ].skipped++;
+#endif
+        return IS25LP_OK;
+    }
+
+    const sIS25LP_PollPolicy_t *policy = &handle->poll[ op ];
+    uint32_t wait_us = IS25LP_StatNow( );
+    uint32_t timeout_ms = s_op_timeouts[ op ];
+    uint32_t tickstart = HAL_GetTick( );
+    eIS25LP_Status_t result = IS25LP_OK;
+
+    // Stay off the bus until shortly before the predicted completion
+    uint32_t predicted_us = IS25LP_PredictReadyUs( handle );
+    uint32_t elapsed_us = IS25LP_GetMicros( ) - handle->timing.issue_us;
+
+    if( elapsed_us < predicted_us )
+    {
+        IS25LP_DelayUs( predicted_us - elapsed_us );
+    }
+
+    if( IS25LP_POLL_CONTINUOUS == policy->mode )
+    {
+        result = IS25LP_PollContinuous( handle, timeout_ms );
+    }
+    else
+    {
+        while(( IS25LP_ReadStatusRegister( handle ) & STATUS_BUSY ) != 0 )
+        {
+            if(( HAL_GetTick( ) - tickstart) > timeout_ms )
+            {
+                result = IS25LP_ERROR;
+                break;
+            }
+
+            if( IS25LP_POLL_BACKOFF_US == policy->mode )
+            {
+                IS25LP_DelayUs( policy->interval_us );
+            }
+            else
+            {
+                HAL_Delay(1);
+            }
+        }
+    }
+
+    if( IS25LP_OK == result )
+    {
+        IS25LP_RecordCompletion( handle );
+        handle->device_idle = true;
+    }
+
+    IS25LP_StatWait( handle, op, wait_us, result );
+
+    return result;
+}
+
+/**
+ * @brief  Apply pending cached writes to data just read from the array
+ * @note   Pending bytes hold the AND of all writes, exactly what programming them will leave.
+ */
+static void IS25LP_CacheOverlay( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+#if IS25LP_WCACHE_LINES > 0
+    for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
+    {
+        const sIS25LP_CacheLine_t *line = &handle->wcache[ n ];
+
+        if( IS25LP_CACHE_INVALID == line->address )
+        {
+            continue;
+        }
+
+        // Overlap of the dirty window with [address, address + length)
+        uint32_t begin = line->address + line->first;
+        uint32_t end = line->address + line->last;
+
+        begin = ( begin > address ) ? begin : address;
+        end = ( end < ( address + length )) ? end : ( address + length );
+
+        for( uint32_t a = begin; a < end; a++ )
+        {
+            buffer[ a - address ] &= line->data[ a - line->address ];
+        }
+    }
+#else
+    ( void )handle;
+    ( void )address;
+    ( void )buffer;
+    ( void )length;
+#endif
+}
+
+/**
+ * @brief  Drop cached writes inside a range that is being erased
+ */
+static void IS25LP_CacheDiscard( sIS25LP_Handle_t *handle, uint32_t address, uint32_t length )
+{
+#if IS25LP_WCACHE_LINES > 0
+    for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
+    {
+        sIS25LP_CacheLine_t *line = &handle->wcache[ n ];
+
+        // Programming before the erase would be lost anyway
+        if(( line->address >= address ) && ( line->address < ( address + length )))
+        {
+            line->address = IS25LP_CACHE_INVALID;
+        }
+    }
+#else
+    ( void )handle;
+    ( void )address;
+    ( void )length;
+#endif
+}
+
+/**
+ * @brief  Send Page Program command and data (does not wait for completion)
+ */
+static eIS25LP_Status_t IS25LP_IssuePageProgram( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint16_t length )
+{
+    // Enable write operations
+    if( IS25LP_OK != IS25LP_WriteEnable( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Prepare command: [CMD][Address High][Address Mid][Address Low]
+    uint8_t cmd[ 4 ] = {
+        CMD_PAGE_PROGRAM,
+        ( uint8_t )(( address >> 16 ) & 0xFF ),
+        ( uint8_t )(( address >> 8 ) & 0xFF ),
+        ( uint8_t )( address & 0xFF )
+    };
+
+    SPI_CS_Low( handle, CMD_PAGE_PROGRAM );
+
+    // Send command and address
+    if( IS25LP_OK != IS25LP_SPI_Transmit( handle, cmd, sizeof(cmd) ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    // Write data
+    if( IS25LP_OK != IS25LP_SPI_Transmit( handle, buffer, length ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    SPI_CS_High( handle );
+
+    IS25LP_MarkIssued( handle, IS25LP_OP_PAGE_PROGRAM, address );
+    IS25LP_ReadCacheInvalidate( handle, address, length );
+    handle->modify_count++;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Send an erase command (does not wait for completion)
+ */
+static eIS25LP_Status_t IS25LP_IssueErase( sIS25LP_Handle_t *handle, eIS25LP_EraseType_t type, uint32_t address )
+{
+    uint8_t command = s_erase_ops[ type ].command;
+
+    // Enable write operations
+    if( IS25LP_OK != IS25LP_WriteEnable( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Prepare command: [CMD][Address High][Address Mid][Address Low], chip erase has no address
+    uint8_t cmd[ 4 ] = {
+        command,
+        ( uint8_t )(( address >> 16 ) & 0xFF ),
+        ( uint8_t )(( address >> 8 ) & 0xFF ),
+        ( uint8_t )( address & 0xFF )
+    };
+    uint16_t cmd_length = ( CMD_CHIP_ERASE == command ) ? 1 : 4;
+
+    SPI_CS_Low( handle, command );
+    eIS25LP_Status_t status = IS25LP_SPI_Transmit( handle, cmd, cmd_length );
+    SPI_CS_High( handle );
+
+    if( IS25LP_OK != status )
+    {
+        return IS25LP_ERROR;
+    }
+
+    IS25LP_MarkIssued( handle, s_erase_ops[ type ].op, address );
+
+    // Pending cached writes inside the erased unit are obsolete
+    IS25LP_CacheDiscard( handle, address & ~( s_erase_ops[ type ].size - 1 ), s_erase_ops[ type ].size );
+    IS25LP_ReadCacheInvalidate( handle, address & ~( s_erase_ops[ type ].size - 1 ), s_erase_ops[ type ].size );
+    handle->modify_count++;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Finish the asynchronous operation and notify the user
+ */
+static void IS25LP_AsyncComplete( sIS25LP_Handle_t *handle, eIS25LP_Status_t status )
+{
+    IS25LP_Callback_t callback = handle->async.callback;
+    void *context = handle->async.context;
+
+    // Back to idle first, the callback may start the next operation
+    handle->async.state = IS25LP_ASYNC_IDLE;
+
+    if( NULL != callback )
+    {
+        callback( handle, status, context );
+    }
+}
+
+/**
+ * @brief  Register handle for DMA callback dispatch
+ */
+static bool IS25LP_RegisterInstance( sIS25LP_Handle_t *handle )
+{
+    for( uint32_t i = 0; i < IS25LP_MAX_INSTANCES; i++ )
+    {
+        if( handle == s_instances[ i ] )
+        {
+            return true;
+        }
+    }
+
+    for( uint32_t i = 0; i < IS25LP_MAX_INSTANCES; i++ )
+    {
+        if( NULL == s_instances[ i ] )
+        {
+            s_instances[ i ] = handle;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  Check if DMA channels are linked to the SPI handle
+ */
+static bool IS25LP_DMAAvailable( sIS25LP_Handle_t *handle )
+{
+#if IS25LP_USE_DMA
+    return ( NULL != handle->spi_handle->hdmarx ) && ( NULL != handle->spi_handle->hdmatx );
+#else
+    ( void )handle;
+    return false;
+#endif
+}
+
+/**
+ * @brief  Start the next DMA chunk of the running transfer
+ */
+static eIS25LP_Status_t IS25LP_StartDMAChunk( sIS25LP_Handle_t *handle )
+{
+    DMA_HandleTypeDef *hdmatx = handle->spi_handle->hdmatx;
+    uint8_t *buffer = handle->xfer.buffer;
+    uint16_t chunk = ( handle->xfer.remaining > DMA_MAX_CHUNK ) ? DMA_MAX_CHUNK : ( uint16_t )handle->xfer.remaining;
+
+    handle->xfer.buffer += chunk;
+    handle->xfer.remaining -= chunk;
+    IS25LP_TrackTransfer( handle, NULL, chunk, IS25LP_OK );
+
+    // TX channel repeats one dummy byte: memory increment off (CCR is only writable while disabled)
+    __HAL_DMA_DISABLE( hdmatx );
+    CLEAR_BIT( hdmatx->Instance->CCR, DMA_CCR_MINC );
+
+    if( HAL_OK != HAL_SPI_TransmitReceive_DMA( handle->spi_handle, ( uint8_t* )&s_dummy_tx, buffer, chunk ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Terminate the running transfer and release CS
+ */
+static void IS25LP_FinishTransfer( sIS25LP_Handle_t *handle, eIS25LP_Status_t status )
+{
+    DMA_HandleTypeDef *hdmatx = handle->spi_handle->hdmatx;
+
+    // Errors and timeouts are charged to the transaction before CS closes it
+    IS25LP_TrackTransfer( handle, NULL, 0, status );
+
+    // A stream keeps CS low between its chunks
+    if(( IS25LP_OK != status ) || !handle->xfer.hold_cs )
+    {
+        SPI_CS_High( handle );
+        handle->xfer.hold_cs = false;
+    }
+
+    // Restore memory increment for other users of the TX channel
+    __HAL_DMA_DISABLE( hdmatx );
+    SET_BIT( hdmatx->Instance->CCR, DMA_CCR_MINC );
+
+    handle->xfer.status = status;
+
+    if( NULL != handle->xfer.result )
+    {
+        handle->xfer.result->status = status;
+        handle->xfer.result->done = true;
+        handle->xfer.result = NULL;
+    }
+
+    handle->xfer.busy = false;
+}
+
+/**
+ * @brief  Terminate the running transfer and complete a pending async read
+ */
+static void IS25LP_EndTransfer( sIS25LP_Handle_t *handle, eIS25LP_Status_t status )
+{
+    // Pending cached writes take precedence over the array (before busy is cleared)
+    if( IS25LP_OK == status )
+    {
+        IS25LP_CacheOverlay( handle, handle->xfer.address, handle->xfer.start, handle->xfer.length );
+    }
+
+    IS25LP_FinishTransfer( handle, status );
+
+    if( IS25LP_ASYNC_READ == handle->async.state )
+    {
+        IS25LP_AsyncComplete( handle, status );
+    }
+}
+
+/**
+ * @brief  Send read command and start receiving data via DMA
+ */
+static eIS25LP_Status_t IS25LP_StartReadDMA( sIS25LP_Handle_t *handle, uint8_t command, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Validate parameters
+    if( NULL == buffer || 0 == length )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // DMA must be linked and idle
+    if( !IS25LP_DMAAvailable( handle ) || handle->xfer.busy )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_READ ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Prepare command: [CMD][Address High][Address Mid][Address Low]([Dummy])
+    uint8_t cmd[ 5 ] = {
+        command,
+        ( uint8_t )(( address >> 16 ) & 0xFF ),
+        ( uint8_t )(( address >> 8 ) & 0xFF ),
+        ( uint8_t )( address & 0xFF ),
+        DUMMY_BYTE
+    };
+    uint16_t cmd_length = ( CMD_FAST_READ == command ) ? 5 : 4;
+
+    SPI_CS_Low( handle, command );
+
+    // Send command and address
+    if( IS25LP_OK != IS25LP_SPI_Transmit( handle, cmd, cmd_length ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    // Mark busy before starting, the callback may fire immediately
+    handle->xfer.address = address;
+    handle->xfer.start = buffer;
+    handle->xfer.length = length;
+    handle->xfer.buffer = buffer;
+    handle->xfer.remaining = length;
+    handle->xfer.status = IS25LP_OK;
+    handle->xfer.hold_cs = false;
+    handle->xfer.busy = true;
+
+    if( IS25LP_OK != IS25LP_StartDMAChunk( handle ))
+    {
+        IS25LP_FinishTransfer( handle, IS25LP_ERROR );
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Initialize Flash
+ */
+eIS25LP_Status_t IS25LP_Init( sIS25LP_Handle_t *handle )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Reset driver state and register for DMA callbacks
+    memset( &handle->xfer, 0, sizeof( handle->xfer ));
+    memset( &handle->async, 0, sizeof( handle->async ));
+    memcpy( handle->poll, s_default_poll, sizeof( handle->poll ));
+    memset( &handle->timing, 0, sizeof( handle->timing ));
+    handle->timing.pending_op = IS25LP_OP_COUNT;
+    handle->device_idle = false;
+    handle->skipped_pages = 0;
+    handle->rcache = NULL;
+    handle->modify_count = 0;
+    memset( &handle->suspend, 0, sizeof( handle->suspend ));
+    handle->suspend.resume_us = IS25LP_GetMicros( ) - TIME_RESUME_US;
+#if IS25LP_USE_STATS
+    memset( &handle->stats, 0, sizeof( handle->stats ));
+    handle->stats.open = IS25LP_STAT_OPCODE_COUNT;
+#endif
+#if IS25LP_TRACE_ENTRIES > 0
+    memset( &handle->trace, 0, sizeof( handle->trace ));
+    handle->trace.magic = IS25LP_TRACE_MAGIC;
+    handle->trace.record_size = sizeof( sIS25LP_TraceRecord_t );
+    handle->trace.entries = IS25LP_TRACE_ENTRIES;
+    handle->trace.enabled = true;
+#endif
+#if IS25LP_WCACHE_LINES > 0
+    for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
+    {
+        handle->wcache[ n ].address = IS25LP_CACHE_INVALID;
+        handle->wcache[ n ].due = false;
+    }
+#endif
+    SPI_CS_Setup( handle );
+
+    // Without a slot its DMA completions would never be seen
+    if( !IS25LP_RegisterInstance( handle ) && IS25LP_DMAAvailable( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Every opcode runs at the CubeMX clock until IS25LP_CalibrateClock() is called
+    handle->clock.read_prescaler = handle->spi_handle->Init.BaudRatePrescaler;
+    handle->clock.fast_prescaler = handle->spi_handle->Init.BaudRatePrescaler;
+
+    // Set CS High (Idle State)
+    SPI_CS_High( handle );
+    HAL_Delay(10);
+
+    // Read JEDEC ID for verification
+    uint8_t manufacturer, memory_type, capacity;
+
+    if( IS25LP_OK != IS25LP_ReadJedecID( handle, &manufacturer, &memory_type, &capacity ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check if it is the correct chip
+    if( IS25LP_MANUFACTURER_ID != manufacturer )
+    {
+        return IS25LP_ERROR;  // Wrong manufacturer
+    }
+
+    if( IS25LP_DEVICE_ID != capacity )
+    {
+        return IS25LP_ERROR;  // Wrong capacity
+    }
+
+    // Mark handle as initialized
+    handle->initialized = true;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Read JEDEC ID (0x9F command)
+ */
+eIS25LP_Status_t IS25LP_ReadJedecID( sIS25LP_Handle_t *handle, uint8_t *manufacturer, uint8_t *memory_type, uint8_t *capacity )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint8_t cmd[4] = { CMD_READ_JEDEC_ID, DUMMY_BYTE, DUMMY_BYTE, DUMMY_BYTE };
+    uint8_t response[ 4 ];
+
+    SPI_CS_Low( handle, CMD_READ_JEDEC_ID );
+    if( IS25LP_OK != IS25LP_SPI_TransmitReceive( handle, cmd, response, sizeof(cmd) ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+    SPI_CS_High( handle );
+
+    *manufacturer = response[ 1 ];  // 0x9D (ISSI)
+    *memory_type = response[ 2 ];   // 0x60
+    *capacity = response[ 3 ];      // 0x13 (4Mbit)
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Read Device ID (0x90 command)
+ */
+eIS25LP_Status_t IS25LP_ReadDeviceID( sIS25LP_Handle_t *handle, uint8_t *manufacturer, uint8_t *device_id )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint8_t cmd[6] = { CMD_READ_DEVICE_ID, 0x00, 0x00, 0x00, DUMMY_BYTE, DUMMY_BYTE };
+    uint8_t response[ 6 ];
+
+    SPI_CS_Low( handle, CMD_READ_DEVICE_ID );
+    if( IS25LP_OK != IS25LP_SPI_TransmitReceive( handle, cmd, response, sizeof(cmd) ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+    SPI_CS_High( handle );
+
+    *manufacturer = response[ 4 ];  // Manufacturer ID
+    *device_id = response[ 5 ];     // Device ID
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Read 64-bit Unique ID (0x4B command)
+ */
+eIS25LP_Status_t IS25LP_ReadUniqueID( sIS25LP_Handle_t *handle, uint8_t *unique_id )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint8_t cmd[ 13 ] = { CMD_READ_UNIQUE_ID };
+    uint8_t response[ 13 ];
+
+    // 4 Dummy Bytes + 8 Unique ID Bytes
+    for (int i = 1; i < 13; i++) {
+        cmd[i] = DUMMY_BYTE;
+    }
+
+    SPI_CS_Low( handle, CMD_READ_UNIQUE_ID );
+    if( IS25LP_OK != IS25LP_SPI_TransmitReceive( handle, cmd, response, sizeof(cmd) ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+    SPI_CS_High( handle );
+
+    // Unique ID starts at byte 5 (after command + 4 dummy bytes)
+    memcpy( unique_id, &response[ 5 ], 8 );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Get Device Info
+ */
+eIS25LP_Status_t IS25LP_GetDeviceInfo( sIS25LP_Handle_t *handle, sIS25LP_DeviceInfo_t *info)
+{
+    // Validate handle parameter
+    if( NULL == handle || NULL == info )
+    {
+        return IS25LP_ERROR;
+    }
+
+    if( !handle->initialized )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Read device information
+    if( IS25LP_OK != IS25LP_ReadJedecID( handle, &info->manufacturer_id, &info->memory_type, &info->capacity ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    if( IS25LP_OK != IS25LP_ReadUniqueID( handle, info->unique_id ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Calibration pattern byte (odd multiplier: every byte value occurs once per page)
+ */
+static inline uint8_t IS25LP_CalPattern( uint32_t index )
+{
+    return ( uint8_t )(( index * 167U ) ^ 0x5AU );
+}
+
+/**
+ * @brief  Read the calibration page with the current clock limits and compare
+ */
+static eIS25LP_Status_t IS25LP_CalCheck( sIS25LP_Handle_t *handle, uint8_t command, uint32_t address, uint8_t *buffer )
+{
+    // Full page (DMA path) and one short frame (LL path)
+    const uint32_t lengths[ 2 ] = { IS25LP_PAGE_SIZE, IS25LP_LL_MAX_FRAME };
+
+    for( uint32_t pass = 0; pass < IS25LP_CAL_PASSES; pass++ )
+    {
+        for( uint32_t n = 0; n < 2; n++ )
+        {
+            memset( buffer, 0, IS25LP_PAGE_SIZE );
+
+            eIS25LP_Status_t status = ( CMD_FAST_READ == command )
+                ? IS25LP_FastRead( handle, address, buffer, lengths[ n ] )
+                : IS25LP_Read( handle, address, buffer, lengths[ n ] );
+
+            if( IS25LP_OK != status )
+            {
+                return IS25LP_ERROR;
+            }
+
+            for( uint32_t i = 0; i < lengths[ n ]; i++ )
+            {
+                if( IS25LP_CalPattern( i ) != buffer[ i ] )
+                {
+                    return IS25LP_ERROR;
+                }
+            }
+        }
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Find the fastest reliable SPI clock per read opcode
+ */
+eIS25LP_Status_t IS25LP_CalibrateClock( sIS25LP_Handle_t *handle, uint32_t address, bool program )
+{
+    uint8_t buffer[ IS25LP_PAGE_SIZE ];
+    const uint32_t slowest = SPI_BAUDRATEPRESCALER_256;
+    const uint8_t commands[ 2 ] = { CMD_READ_DATA, CMD_FAST_READ };
+
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    sIS25LP_Clock_t previous = handle->clock;
+
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    address &= ~( uint32_t )( IS25LP_PAGE_SIZE - 1 );
+    if( address >= IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Reference run at the slowest clock, program the pattern if missing and allowed
+    handle->clock.read_prescaler = slowest;
+    handle->clock.fast_prescaler = slowest;
+
+    if( IS25LP_OK != IS25LP_CalCheck( handle, CMD_READ_DATA, address, buffer ))
+    {
+        for( uint32_t i = 0; i < IS25LP_PAGE_SIZE; i++ )
+        {
+            buffer[ i ] = IS25LP_CalPattern( i );
+        }
+
+        // Never erase user data unless the caller opted in
+        if( !program || ( IS25LP_OK != IS25LP_EraseSector( handle, address & ~( uint32_t )( IS25LP_SECTOR_SIZE - 1 )))
+            || ( IS25LP_OK != IS25LP_WritePage( handle, address, buffer, IS25LP_PAGE_SIZE ))
+            || ( IS25LP_OK != IS25LP_CalCheck( handle, CMD_READ_DATA, address, buffer )))
+        {
+            handle->clock = previous;
+            return IS25LP_ERROR;
+        }
+    }
+
+    // Sweep each opcode from slow to fast, keep the last setting that passed
+    for( uint32_t n = 0; n < 2; n++ )
+    {
+        uint32_t *limit = ( CMD_READ_DATA == commands[ n ] ) ? &handle->clock.read_prescaler : &handle->clock.fast_prescaler;
+        uint32_t max_hz = ( CMD_READ_DATA == commands[ n ] ) ? FREQ_READ_MAX : FREQ_FAST_MAX;
+        uint32_t best = slowest;
+
+        for( int32_t br = ( int32_t )( slowest >> SPI_CR1_BR_Pos ); br >= 0; br-- )
+        {
+            // Divider is 2^(BR+1), skip clocks above the datasheet limit
+            if(( HAL_RCC_GetPCLK1Freq( ) >> ( br + 1 )) > max_hz )
+            {
+                break;
+            }
+
+            *limit = ( uint32_t )br << SPI_CR1_BR_Pos;
+
+            if( IS25LP_OK != IS25LP_CalCheck( handle, commands[ n ], address, buffer ))
+            {
+                break;
+            }
+
+            best = *limit;
+        }
+
+        *limit = best;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Flash range the running program/erase changes
+ */
+static void IS25LP_BusyRange( sIS25LP_Handle_t *handle, uint32_t *start, uint32_t *size )
+{
+    *size = IS25LP_PAGE_SIZE;
+
+    for( uint32_t i = 0; i < ( sizeof( s_erase_ops ) / sizeof( s_erase_ops[ 0 ] )); i++ )
+    {
+        if( s_erase_ops[ i ].op == handle->timing.pending_op )
+        {
+            *size = s_erase_ops[ i ].size;
+        }
+    }
+
+    *start = handle->timing.issue_address & ~( *size - 1 );
+}
+
+/**
+ * @brief  Serve a read by suspending the running async program/erase around it
+ */
+static eIS25LP_Status_t IS25LP_ReadSuspended( sIS25LP_Handle_t *handle, eIS25LP_Status_t ( *read )( sIS25LP_Handle_t *, uint32_t, uint8_t *, uint32_t ), uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    uint32_t busy_start, busy_size;
+
+    // Only programs and erases can be suspended, and only if allowed
+    if( !handle->read_suspend || (( IS25LP_ASYNC_PROGRAM != handle->async.state ) && ( IS25LP_ASYNC_ERASE != handle->async.state )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Validate parameters
+    if( NULL == buffer || 0 == length || ( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // The unit being changed reads undefined data while suspended
+    IS25LP_BusyRange( handle, &busy_start, &busy_size );
+
+    if(( address < ( busy_start + busy_size )) && (( address + length ) > busy_start ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    if( IS25LP_OK != IS25LP_Suspend( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    eIS25LP_Status_t status = read( handle, address, buffer, length );
+
+    if( IS25LP_OK != IS25LP_Resume( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return status;
+}
+
+/**
+ * @brief  Read data from Flash memory
+ */
+eIS25LP_Status_t IS25LP_Read( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // A running program/erase is suspended for the read if the policy allows it
+    if(( IS25LP_ASYNC_IDLE != handle->async.state ) && !handle->suspend.active )
+    {
+        return IS25LP_ReadSuspended( handle, IS25LP_Read, address, buffer, length );
+    }
+
+    // Validate parameters
+    if( NULL == buffer || 0 == length )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Let a background read finish before starting a new one
+    if( IS25LP_OK != IS25LP_DrainTransfer( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Large reads: DMA engine, wait for completion
+    if(( length >= IS25LP_DMA_THRESHOLD ) && IS25LP_DMAAvailable( handle ))
+    {
+        if( IS25LP_OK != IS25LP_StartReadDMA( handle, CMD_READ_DATA, address, buffer, length ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        return IS25LP_WaitTransfer( handle, IS25LP_TransferTimeout( handle, length ));
+    }
+
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_READ ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Prepare command: [CMD][Address High][Address Mid][Address Low]
+    uint8_t cmd[ 4 ] = {
+        CMD_READ_DATA,
+        ( uint8_t )(( address >> 16 ) & 0xFF ),
+        ( uint8_t )(( address >> 8 ) & 0xFF ),
+        ( uint8_t )( address & 0xFF )
+    };
+
+    SPI_CS_Low( handle, CMD_READ_DATA );
+
+    // Send command and address
+    if( IS25LP_OK != IS25LP_SPI_Transmit( handle, cmd, sizeof(cmd) ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    // Read data
+    if( IS25LP_OK != IS25LP_SPI_Receive( handle, buffer, length ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    SPI_CS_High( handle );
+
+    // Pending cached writes take precedence over the array
+    IS25LP_CacheOverlay( handle, address, buffer, length );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Fast read data from Flash memory
+ */
+eIS25LP_Status_t IS25LP_FastRead( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // A running program/erase is suspended for the read if the policy allows it
+    if(( IS25LP_ASYNC_IDLE != handle->async.state ) && !handle->suspend.active )
+    {
+        return IS25LP_ReadSuspended( handle, IS25LP_FastRead, address, buffer, length );
+    }
+
+    // Validate parameters
+    if( NULL == buffer || 0 == length )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Let a background read finish before starting a new one
+    if( IS25LP_OK != IS25LP_DrainTransfer( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Large reads: DMA engine, wait for completion
+    if(( length >= IS25LP_DMA_THRESHOLD ) && IS25LP_DMAAvailable( handle ))
+    {
+        if( IS25LP_OK != IS25LP_StartReadDMA( handle, CMD_FAST_READ, address, buffer, length ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        return IS25LP_WaitTransfer( handle, IS25LP_TransferTimeout( handle, length ));
+    }
+
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_READ ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Prepare command: [CMD][Address High][Address Mid][Address Low][Dummy]
+    uint8_t cmd[ 5 ] = {
+        CMD_FAST_READ,
+        ( uint8_t )(( address >> 16 ) & 0xFF ),
+        ( uint8_t )(( address >> 8 ) & 0xFF ),
+        ( uint8_t )( address & 0xFF ),
+        DUMMY_BYTE
+    };
+
+    SPI_CS_Low( handle, CMD_FAST_READ );
+
+    // Send command, address, and dummy byte
+    if( IS25LP_OK != IS25LP_SPI_Transmit( handle, cmd, sizeof(cmd) ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    // Read data
+    if( IS25LP_OK != IS25LP_SPI_Receive( handle, buffer, length ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    SPI_CS_High( handle );
+
+    // Pending cached writes take precedence over the array
+    IS25LP_CacheOverlay( handle, address, buffer, length );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Start a DMA read (0x03 command)
+ */
+eIS25LP_Status_t IS25LP_ReadDMA( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_IsAsyncBusy( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_StartReadDMA( handle, CMD_READ_DATA, address, buffer, length );
+}
+
+/**
+ * @brief  Start a DMA fast read (0x0B command)
+ */
+eIS25LP_Status_t IS25LP_FastReadDMA( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_IsAsyncBusy( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_StartReadDMA( handle, CMD_FAST_READ, address, buffer, length );
+}
+
+/**
+ * @brief  Start a DMA fast read that reports its own outcome
+ */
+eIS25LP_Status_t IS25LP_FastReadDMAResult( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length, sIS25LP_TransferResult_t *result )
+{
+    // Validate parameters, the result slot belongs to the next transfer only
+    if(( NULL == handle ) || ( NULL == result ) || IS25LP_IsAsyncBusy( handle ) || handle->xfer.busy )
+    {
+        return IS25LP_ERROR;
+    }
+
+    result->done = false;
+    handle->xfer.result = result;
+
+    if( IS25LP_OK != IS25LP_StartReadDMA( handle, CMD_FAST_READ, address, buffer, length ))
+    {
+        handle->xfer.result = NULL;
+        result->status = IS25LP_ERROR;
+        result->done = true;
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Check if a DMA transfer is in flight
+ */
+bool IS25LP_IsTransferBusy( sIS25LP_Handle_t *handle )
+{
+    return ( NULL != handle ) && handle->xfer.busy;
+}
+
+/**
+ * @brief  Wait for the running DMA transfer to complete
+ */
+eIS25LP_Status_t IS25LP_WaitTransfer( sIS25LP_Handle_t *handle, uint32_t timeout_ms )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint32_t tickstart = HAL_GetTick( );
+
+    while( handle->xfer.busy )
+    {
+        if(( HAL_GetTick( ) - tickstart ) > timeout_ms )
+        {
+            HAL_SPI_Abort( handle->spi_handle );
+            IS25LP_EndTransfer( handle, IS25LP_ERROR );
+            return IS25LP_ERROR;
+        }
+    }
+
+    return handle->xfer.status;
+}
+
+/**
+ * @brief  SPI DMA completion hook (call from HAL_SPI_TxRxCpltCallback)
+ */
+void IS25LP_SPI_TxRxCpltCallback( SPI_HandleTypeDef *hspi )
+{
+    sIS25LP_Handle_t *handle = IS25LP_FindTransferOwner( hspi );
+
+    if( NULL == handle )
+    {
+        return;
+    }
+
+    // Chain the next chunk, CS stays low so the read continues seamlessly
+    if( handle->xfer.remaining > 0 )
+    {
+        if( IS25LP_OK != IS25LP_StartDMAChunk( handle ))
+        {
+            IS25LP_EndTransfer( handle, IS25LP_ERROR );
+        }
+        return;
+    }
+
+    IS25LP_EndTransfer( handle, IS25LP_OK );
+}
+
+/**
+ * @brief  SPI DMA error hook (call from HAL_SPI_ErrorCallback)
+ */
+void IS25LP_SPI_ErrorCallback( SPI_HandleTypeDef *hspi )
+{
+    sIS25LP_Handle_t *handle = IS25LP_FindTransferOwner( hspi );
+
+    if( NULL == handle )
+    {
+        return;
+    }
+
+    IS25LP_EndTransfer( handle, IS25LP_ERROR );
+}
+
+/**
+ * @brief  Set the ping-pong buffers for streaming reads
+ */
+eIS25LP_Status_t IS25LP_SetStreamBuffers( sIS25LP_Handle_t *handle, uint8_t *buffer0, uint8_t *buffer1, uint16_t chunk_size )
+{
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == buffer0 ) || ( NULL == buffer1 ) || ( 0 == chunk_size ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    handle->stream.buffer[ 0 ] = buffer0;
+    handle->stream.buffer[ 1 ] = buffer1;
+    handle->stream.chunk_size = chunk_size;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Set the sector image buffer for IS25LP_Update
+ */
+eIS25LP_Status_t IS25LP_SetSectorBuffer( sIS25LP_Handle_t *handle, uint8_t *buffer )
+{
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == buffer ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    handle->sector_buffer = buffer;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Read a range into a consumer callback
+ */
+eIS25LP_Status_t IS25LP_ReadStream( sIS25LP_Handle_t *handle, uint32_t address, uint32_t length, IS25LP_StreamSink_t sink, void *context )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Validate parameters
+    if(( NULL == sink ) || ( 0 == length ) || ( 0 == handle->stream.chunk_size ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Reject while an asynchronous operation owns the device, let a background read finish
+    if( IS25LP_IsAsyncBusy( handle ) || ( IS25LP_OK != IS25LP_DrainTransfer( handle )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_READ ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Prepare command: [CMD][Address High][Address Mid][Address Low][Dummy]
+    uint8_t cmd[ 5 ] = {
+        CMD_FAST_READ,
+        ( uint8_t )(( address >> 16 ) & 0xFF ),
+        ( uint8_t )(( address >> 8 ) & 0xFF ),
+        ( uint8_t )( address & 0xFF ),
+        DUMMY_BYTE
+    };
+    bool use_dma = IS25LP_DMAAvailable( handle );
+    uint8_t index = 0;
+    uint32_t chunk = ( length > handle->stream.chunk_size ) ? handle->stream.chunk_size : length;
+
+    SPI_CS_Low( handle, CMD_FAST_READ );
+
+    // Send command and address
+    if( IS25LP_OK != IS25LP_SPI_Transmit( handle, cmd, sizeof(cmd) ))
+    {
+        SPI_CS_High( handle );
+        return IS25LP_ERROR;
+    }
+
+    if( !use_dma )
+    {
+        // Blocking fallback, still one continuous read command
+        while( length > 0 )
+        {
+            if( IS25LP_OK != IS25LP_SPI_Receive( handle, handle->stream.buffer[ 0 ], chunk ))
+            {
+                SPI_CS_High( handle );
+                return IS25LP_ERROR;
+            }
+
+            IS25LP_CacheOverlay( handle, address, handle->stream.buffer[ 0 ], chunk );
+
+            if( IS25LP_OK != sink( handle, address, handle->stream.buffer[ 0 ], chunk, context ))
+            {
+                SPI_CS_High( handle );
+                return IS25LP_ERROR;
+            }
+
+            address += chunk;
+            length -= chunk;
+            chunk = ( length > handle->stream.chunk_size ) ? handle->stream.chunk_size : length;
+        }
+
+        SPI_CS_High( handle );
+        return IS25LP_OK;
+    }
+
+    // First chunk, CS is held low between chunks (cache overlay is applied per chunk below)
+    handle->xfer.length = 0;
+    handle->xfer.buffer = handle->stream.buffer[ index ];
+    handle->xfer.remaining = chunk;
+    handle->xfer.status = IS25LP_OK;
+    handle->xfer.hold_cs = true;
+    handle->xfer.busy = true;
+
+    if( IS25LP_OK != IS25LP_StartDMAChunk( handle ))
+    {
+        IS25LP_FinishTransfer( handle, IS25LP_ERROR );
+        return IS25LP_ERROR;
+    }
+
+    while( length > 0 )
+    {
+        uint8_t *ready = handle->stream.buffer[ index ];
+        uint32_t ready_length = chunk;
+
+        // Releases CS on error or timeout
+        if( IS25LP_OK != IS25LP_WaitTransfer( handle, IS25LP_TransferTimeout( handle, ready_length )))
+        {
+            return IS25LP_ERROR;
+        }
+
+        length -= ready_length;
+        chunk = ( length > handle->stream.chunk_size ) ? handle->stream.chunk_size : length;
+        index ^= 1;
+
+        // Refill the other buffer before handing this one to the sink
+        if( length > 0 )
+        {
+            handle->xfer.buffer = handle->stream.buffer[ index ];
+            handle->xfer.remaining = chunk;
+            handle->xfer.busy = true;
+
+            if( IS25LP_OK != IS25LP_StartDMAChunk( handle ))
+            {
+                IS25LP_FinishTransfer( handle, IS25LP_ERROR );
+                return IS25LP_ERROR;
+            }
+        }
+
+        IS25LP_CacheOverlay( handle, address, ready, ready_length );
+
+        if( IS25LP_OK != sink( handle, address, ready, ready_length, context ))
+        {
+            if( handle->xfer.busy )
+            {
+                HAL_SPI_Abort( handle->spi_handle );
+            }
+            IS25LP_FinishTransfer( handle, IS25LP_ERROR );
+            return IS25LP_ERROR;
+        }
+
+        address += ready_length;
+    }
+
+    handle->xfer.hold_cs = false;
+    IS25LP_FinishTransfer( handle, IS25LP_OK );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Write one page to Flash memory
+ */
+eIS25LP_Status_t IS25LP_WritePage( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint16_t length )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Validate parameters
+    if( NULL == buffer || 0 == length || length > IS25LP_PAGE_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if( address >= IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Ensure write does not cross page boundary
+    uint32_t page_offset = address % IS25LP_PAGE_SIZE;
+    if(( page_offset + length ) > IS25LP_PAGE_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_PAGE_PROGRAM ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Send program command and data
+    if( IS25LP_OK != IS25LP_IssuePageProgram( handle, address, buffer, length ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Wait for write operation to complete
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_PAGE_PROGRAM ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Find the slice of a page that needs programming (0xFF bytes leave the cells untouched)
+ * @note   first == last when the whole slice is 0xFF
+ */
+static void IS25LP_TrimErased( const uint8_t *data, uint32_t length, uint32_t *first, uint32_t *last )
+{
+    uint32_t begin = 0;
+    uint32_t end = length;
+
+    while(( begin < end ) && ( 0xFF == data[ begin ] ))
+    {
+        begin++;
+    }
+
+#if IS25LP_WRITE_TRIM_FF
+    while(( end > begin ) && ( 0xFF == data[ end - 1 ] ))
+    {
+        end--;
+    }
+#else
+    if( begin < end )
+    {
+        begin = 0;
+    }
+#endif
+
+    *first = begin;
+    *last = end;
+}
+
+/**
+ * @brief  Write data page by page, preparing the next page during tPP
+ */
+eIS25LP_Status_t IS25LP_WritePipelined( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_PrepareHook_t prepare, void *context )
+{
+    // Staging buffer, free again once the page data has been shifted out
+    uint8_t stage[ IS25LP_PAGE_SIZE ];
+
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Validate parameters
+    if( NULL == buffer || 0 == length )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint32_t bytes_written = 0;
+    uint32_t current_address = address;
+    const uint8_t *current_buffer = buffer;
+
+    while( bytes_written < length )
+    {
+        // Calculate bytes remaining in current page, write only up to page boundary
+        uint32_t bytes_to_write = IS25LP_PAGE_SIZE - ( current_address % IS25LP_PAGE_SIZE );
+
+        if( bytes_to_write > ( length - bytes_written ))
+        {
+            bytes_to_write = length - bytes_written;
+        }
+
+        // Stage this page while the previous one is still programming
+        const uint8_t *page = current_buffer;
+
+        if( NULL != prepare )
+        {
+            if( IS25LP_OK != prepare( handle, current_address, current_buffer, stage, ( uint16_t )bytes_to_write, context ))
+            {
+                return IS25LP_ERROR;
+            }
+            page = stage;
+        }
+
+        uint32_t first;
+        uint32_t last;
+
+        IS25LP_TrimErased( page, bytes_to_write, &first, &last );
+
+        if( first == last )
+        {
+            handle->skipped_pages++;
+        }
+        else
+        {
+            // Issue as soon as WIP of the previous page clears, do not wait for this one
+            if(( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_PAGE_PROGRAM ))
+                || ( IS25LP_OK != IS25LP_IssuePageProgram( handle, current_address + first, page + first, ( uint16_t )( last - first ))))
+            {
+                return IS25LP_ERROR;
+            }
+        }
+
+        // Update counters and pointers
+        bytes_written += bytes_to_write;
+        current_address += bytes_to_write;
+        current_buffer += bytes_to_write;
+    }
+
+    // Wait for the last page
+    return IS25LP_WaitForReady( handle, IS25LP_OP_PAGE_PROGRAM );
+}
+
+#if IS25LP_WCACHE_LINES > 0
+/**
+ * @brief  Program the dirty window of a cache line and release it
+ */
+static eIS25LP_Status_t IS25LP_CacheFlushLine( sIS25LP_Handle_t *handle, sIS25LP_CacheLine_t *line )
+{
+    // Keep the line on failure, the data was already reported as written
+    if( IS25LP_OK != IS25LP_WritePipelined( handle, line->address + line->first, &line->data[ line->first ], line->last - line->first, NULL, NULL ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    line->address = IS25LP_CACHE_INVALID;
+    line->due = false;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Program the cache lines IS25LP_AsyncTick marked as due
+ */
+static eIS25LP_Status_t IS25LP_CacheFlushDue( sIS25LP_Handle_t *handle )
+{
+    for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
+    {
+        sIS25LP_CacheLine_t *line = &handle->wcache[ n ];
+
+        if(( IS25LP_CACHE_INVALID != line->address ) && line->due && ( IS25LP_OK != IS25LP_CacheFlushLine( handle, line )))
+        {
+            return IS25LP_ERROR;
+        }
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Merge a write into the page cache, flushing pages that became full
+ */
+static eIS25LP_Status_t IS25LP_CacheWrite( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length )
+{
+    while( length > 0 )
+    {
+        uint32_t page = address & ~( uint32_t )( IS25LP_PAGE_SIZE - 1 );
+        uint32_t offset = address - page;
+        uint32_t chunk = IS25LP_PAGE_SIZE - offset;
+        sIS25LP_CacheLine_t *line = NULL;
+        sIS25LP_CacheLine_t *oldest = &handle->wcache[ 0 ];
+
+        if( chunk > length )
+        {
+            chunk = length;
+        }
+
+        // Hit, else a free line, else evict the oldest
+        for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
+        {
+            sIS25LP_CacheLine_t *candidate = &handle->wcache[ n ];
+
+            if( page == candidate->address )
+            {
+                line = candidate;
+                break;
+            }
+
+            if(( NULL == line ) && ( IS25LP_CACHE_INVALID == candidate->address ))
+            {
+                line = candidate;
+            }
+
+            if(( int32_t )( candidate->tick - oldest->tick ) < 0 )
+            {
+                oldest = candidate;
+            }
+        }
+
+        if( NULL == line )
+        {
+            if( IS25LP_OK != IS25LP_CacheFlushLine( handle, oldest ))
+            {
+                return IS25LP_ERROR;
+            }
+            line = oldest;
+        }
+
+        if( page != line->address )
+        {
+            // Fresh tick before the address, a tick interrupt must not see the new page as old
+            memset( line->data, 0xFF, sizeof( line->data ));
+            line->tick = HAL_GetTick( );
+            line->first = ( uint16_t )offset;
+            line->last = ( uint16_t )( offset + chunk );
+            line->address = page;
+            line->due = false;
+        }
+
+        // Same result as programming both writes: bits can only be cleared
+        for( uint32_t i = 0; i < chunk; i++ )
+        {
+            line->data[ offset + i ] &= buffer[ i ];
+        }
+
+        line->first = ( offset < line->first ) ? ( uint16_t )offset : line->first;
+        line->last = (( offset + chunk ) > line->last ) ? ( uint16_t )( offset + chunk ) : line->last;
+
+        // Complete page: program it in one go
+        if(( 0 == line->first ) && ( IS25LP_PAGE_SIZE == line->last ))
+        {
+            if( IS25LP_OK != IS25LP_CacheFlushLine( handle, line ))
+            {
+                return IS25LP_ERROR;
+            }
+        }
+
+        address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return IS25LP_OK;
+}
+#endif
+
+/**
+ * @brief  Program all pending cached writes
+ */
+eIS25LP_Status_t IS25LP_Flush( sIS25LP_Handle_t *handle )
+{
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+#if IS25LP_WCACHE_LINES > 0
+    eIS25LP_Status_t status = IS25LP_OK;
+
+    for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
+    {
+        if(( IS25LP_CACHE_INVALID != handle->wcache[ n ].address )
+            && ( IS25LP_OK != IS25LP_CacheFlushLine( handle, &handle->wcache[ n ] )))
+        {
+            status = IS25LP_ERROR;
+        }
+    }
+
+    return status;
+#else
+    return IS25LP_OK;
+#endif
+}
+
+/**
+ * @brief  Write data to Flash memory (multi-page)
+ */
+eIS25LP_Status_t IS25LP_Write( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length )
+{
+#if IS25LP_WCACHE_LINES > 0
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == buffer ) || ( 0 == length ) || (( address + length ) > IS25LP_CHIP_SIZE ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Reject while an asynchronous operation owns the device, let a background read finish
+    if(( IS25LP_ASYNC_IDLE != handle->async.state ) || ( IS25LP_OK != IS25LP_DrainTransfer( handle )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Pages that timed out first, a failure is reported before new data is taken
+    if( IS25LP_OK != IS25LP_CacheFlushDue( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Read cache lines and prefetch windows would miss the pending data
+    IS25LP_ReadCacheInvalidate( handle, address, length );
+    handle->modify_count++;
+
+    return IS25LP_CacheWrite( handle, address, buffer, length );
+#else
+    return IS25LP_WritePipelined( handle, address, buffer, length, NULL, NULL );
+#endif
+}
+
+/**
+ * @brief  Update one sector, erasing only if 1->0 programming cannot reach the data
+ */
+static eIS25LP_Status_t IS25LP_UpdateSector( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *data, uint32_t length )
+{
+    uint32_t sector = address & ~( uint32_t )( IS25LP_SECTOR_SIZE - 1 );
+    uint8_t page[ IS25LP_PAGE_SIZE ];
+    uint32_t dirty = 0;         // Bit n set: page n of the sector differs
+    bool needs_erase = false;
+
+    // Pass 1: compare the affected window page by page
+    for( uint32_t done = 0; done < length; )
+    {
+        uint32_t current = address + done;
+        uint32_t chunk = IS25LP_PAGE_SIZE - ( current % IS25LP_PAGE_SIZE );
+
+        if( chunk > ( length - done ))
+        {
+            chunk = length - done;
+        }
+
+        if( IS25LP_OK != IS25LP_FastRead( handle, current, page, chunk ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        for( uint32_t i = 0; i < chunk; i++ )
+        {
+            uint8_t wanted = data[ done + i ];
+
+            if( page[ i ] != wanted )
+            {
+                dirty |= 1UL << (( current - sector ) / IS25LP_PAGE_SIZE );
+
+                // Programming can only clear bits
+                if(( page[ i ] & wanted ) != wanted )
+                {
+                    needs_erase = true;
+                }
+            }
+        }
+
+        done += chunk;
+    }
+
+    if( 0 == dirty )
+    {
+        return IS25LP_OK;
+    }
+
+    // Pass 2a: program only the differing pages, bits that stay 1 are left untouched
+    if( !needs_erase )
+    {
+        for( uint32_t done = 0; done < length; )
+        {
+            uint32_t current = address + done;
+            uint32_t chunk = IS25LP_PAGE_SIZE - ( current % IS25LP_PAGE_SIZE );
+
+            if( chunk > ( length - done ))
+            {
+                chunk = length - done;
+            }
+
+            if(( dirty & ( 1UL << (( current - sector ) / IS25LP_PAGE_SIZE ))) &&
+                ( IS25LP_OK != IS25LP_WritePage( handle, current, &data[ done ], ( uint16_t )chunk )))
+            {
+                return IS25LP_ERROR;
+            }
+
+            done += chunk;
+        }
+
+        return IS25LP_OK;
+    }
+
+    // Pass 2b: merge into a sector image, erase and program all non-blank pages
+    uint8_t *image = handle->sector_buffer;
+
+    if(( NULL == image ) || ( IS25LP_OK != IS25LP_FastRead( handle, sector, image, IS25LP_SECTOR_SIZE )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    memcpy( &image[ address - sector ], data, length );
+
+    if( IS25LP_OK != IS25LP_EraseSector( handle, sector ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    for( uint32_t offset = 0; offset < IS25LP_SECTOR_SIZE; offset += IS25LP_PAGE_SIZE )
+    {
+        const uint8_t *page_image = &image[ offset ];
+        bool blank = true;
+
+        for( uint32_t i = 0; i < IS25LP_PAGE_SIZE; i++ )
+        {
+            if( 0xFF != page_image[ i ] )
+            {
+                blank = false;
+                break;
+            }
+        }
+
+        if( !blank && ( IS25LP_OK != IS25LP_WritePage( handle, sector + offset, page_image, IS25LP_PAGE_SIZE )))
+        {
+            return IS25LP_ERROR;
+        }
+    }
+
+    return IS25LP_OK;
 }
 
 /**
- * @brief  Write Enable command
+ * @brief  Update data in place with the least erase effort
  */
-static eIS25LP_Status_t IS25LP_WriteEnable( sIS25LP_Handle_t *handle )
+eIS25LP_Status_t IS25LP_Update( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *data, uint32_t length )
 {
-    uint8_t cmd = CMD_WRITE_ENABLE;
+    // Validate handle parameter
+    if( NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
 
-    SPI_CS_Low( handle );
-    uint8_t status = HAL_SPI_Transmit( handle->spi_handle, &cmd, sizeof(cmd), TIMEOUT_SPI );
-    SPI_CS_High( handle );
+    // Validate parameters
+    if( NULL == data || 0 == length )
+    {
+        return IS25LP_ERROR;
+    }
 
-    return (HAL_OK == status ) ? IS25LP_OK : IS25LP_ERROR;
-}
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
 
-/**
- * @brief  Read Status Register
- */
-static uint8_t IS25LP_ReadStatusRegister( sIS25LP_Handle_t *handle )
-{
-    uint8_t cmd[2] = { CMD_READ_STATUS_REG, DUMMY_BYTE };
-    uint8_t response[ 2 ];
+    while( length > 0 )
+    {
+        // Handle one sector at a time
+        uint32_t chunk = IS25LP_SECTOR_SIZE - ( address % IS25LP_SECTOR_SIZE );
 
-    SPI_CS_Low( handle );
-    HAL_SPI_TransmitReceive( handle->spi_handle, cmd, response, sizeof(cmd), TIMEOUT_SPI );
-    SPI_CS_High( handle );
+        if( chunk > length )
+        {
+            chunk = length;
+        }
 
-    return response[ 1 ];
+        if( IS25LP_OK != IS25LP_UpdateSector( handle, address, data, chunk ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+
+    return IS25LP_OK;
 }
 
 /**
- * @brief  Wait until Flash is ready (WIP Bit = 0)
+ * @brief  Check if a range is erased (all 0xFF)
  */
-static eIS25LP_Status_t IS25LP_WaitForReady( sIS25LP_Handle_t *handle, uint32_t timeout_ms )
+bool IS25LP_IsBlank( sIS25LP_Handle_t *handle, uint32_t address, uint32_t length )
 {
-    uint32_t tickstart = HAL_GetTick( );
+    // Word buffer so the comparison runs 32 bits at a time
+    uint32_t words[ IS25LP_PAGE_SIZE / sizeof( uint32_t )];
 
-    while(( IS25LP_ReadStatusRegister( handle ) & STATUS_BUSY ) != 0 )
+    // Validate parameters
+    if(( NULL == handle ) || ( 0 == length ) || (( address + length ) > IS25LP_CHIP_SIZE ))
+    {
+        return false;
+    }
+
+    while( length > 0 )
     {
-        if(( HAL_GetTick( ) - tickstart) > timeout_ms )
+        uint32_t chunk = ( length > sizeof( words )) ? sizeof( words ) : length;
+        uint32_t count = chunk / sizeof( uint32_t );
+
+        if( IS25LP_OK != IS25LP_FastRead( handle, address, ( uint8_t* )words, chunk ))
         {
-            return IS25LP_ERROR;
+            return false;
+        }
+
+        // Stop at the first programmed word
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            if( 0xFFFFFFFFUL != words[ i ] )
+            {
+                return false;
+            }
+        }
+
+        // Trailing bytes of an unaligned length
+        for( uint32_t i = count * sizeof( uint32_t ); i < chunk; i++ )
+        {
+            if( 0xFF != (( uint8_t* )words )[ i ] )
+            {
+                return false;
+            }
         }
-        HAL_Delay(1);
+
+        address += chunk;
+        length -= chunk;
     }
 
-    return IS25LP_OK;
+    return true;
 }
 
 /**
- * @brief  Initialize Flash
+ * @brief  Check if an erase can be skipped because the unit is blank
  */
-eIS25LP_Status_t IS25LP_Init( sIS25LP_Handle_t *handle )
+static bool IS25LP_SkipErase( sIS25LP_Handle_t *handle, uint32_t address, uint32_t length )
+{
+    return handle->erase_skip_blank && IS25LP_IsBlank( handle, address, length );
+}
+
+/**
+ * @brief  Erase a 4KB sector
+ */
+eIS25LP_Status_t IS25LP_EraseSector( sIS25LP_Handle_t *handle, uint32_t address )
 {
     // Validate handle parameter
     if( NULL == handle )
@@ -130,39 +2637,52 @@ eIS25LP_Status_t IS25LP_Init( sIS25LP_Handle_t *handle )
         return IS25LP_ERROR;
     }
 
-    // Set CS High (Idle State)
-    SPI_CS_High( handle );
-    HAL_Delay(10);
-
-    // Read JEDEC ID for verification
-    uint8_t manufacturer, memory_type, capacity;
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
+    {
+        return IS25LP_ERROR;
+    }
 
-    if( IS25LP_OK != IS25LP_ReadJedecID( handle, &manufacturer, &memory_type, &capacity ))
+    // Check address range
+    if( address >= IS25LP_CHIP_SIZE )
     {
         return IS25LP_ERROR;
     }
 
-    // Check if it is the correct chip
-    if( IS25LP_MANUFACTURER_ID != manufacturer )
+    // Align address to sector boundary
+    address = ( address / IS25LP_SECTOR_SIZE ) * IS25LP_SECTOR_SIZE;
+
+    // Nothing to do if the sector is already erased
+    if( IS25LP_SkipErase( handle, address, IS25LP_SECTOR_SIZE ))
     {
-        return IS25LP_ERROR;  // Wrong manufacturer
+        return IS25LP_OK;
     }
 
-    if( IS25LP_DEVICE_ID != capacity )
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_SECTOR_ERASE ))
     {
-        return IS25LP_ERROR;  // Wrong capacity
+        return IS25LP_ERROR;
     }
 
-    // Mark handle as initialized
-    handle->initialized = true;
+    // Send erase command
+    if( IS25LP_OK != IS25LP_IssueErase( handle, IS25LP_ERASE_SECTOR, address ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Wait for erase operation to complete
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_SECTOR_ERASE ))
+    {
+        return IS25LP_ERROR;
+    }
 
     return IS25LP_OK;
 }
 
 /**
- * @brief  Read JEDEC ID (0x9F command)
+ * @brief  Erase a 32KB block
  */
-eIS25LP_Status_t IS25LP_ReadJedecID( sIS25LP_Handle_t *handle, uint8_t *manufacturer, uint8_t *memory_type, uint8_t *capacity )
+eIS25LP_Status_t IS25LP_EraseBlock32K( sIS25LP_Handle_t *handle, uint32_t address )
 {
     // Validate handle parameter
     if( NULL == handle )
@@ -170,56 +2690,52 @@ eIS25LP_Status_t IS25LP_ReadJedecID( sIS25LP_Handle_t *handle, uint8_t *manufact
         return IS25LP_ERROR;
     }
 
-    uint8_t cmd[4] = { CMD_READ_JEDEC_ID, DUMMY_BYTE, DUMMY_BYTE, DUMMY_BYTE };
-    uint8_t response[ 4 ];
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
+    {
+        return IS25LP_ERROR;
+    }
 
-    SPI_CS_Low( handle );
-    if( HAL_OK != HAL_SPI_TransmitReceive( handle->spi_handle, cmd, response, sizeof(cmd), TIMEOUT_SPI ))
+    // Check address range
+    if( address >= IS25LP_CHIP_SIZE )
     {
-        SPI_CS_High( handle );
         return IS25LP_ERROR;
     }
-    SPI_CS_High( handle );
 
-    *manufacturer = response[ 1 ];  // 0x9D (ISSI)
-    *memory_type = response[ 2 ];   // 0x60
-    *capacity = response[ 3 ];      // 0x13 (4Mbit)
+    // Align address to 32KB block boundary
+    address = ( address / IS25LP_BLOCK_32K_SIZE ) * IS25LP_BLOCK_32K_SIZE;
 
-    return IS25LP_OK;
-}
+    // Nothing to do if the block is already erased
+    if( IS25LP_SkipErase( handle, address, IS25LP_BLOCK_32K_SIZE ))
+    {
+        return IS25LP_OK;
+    }
 
-/**
- * @brief  Read Device ID (0x90 command)
- */
-eIS25LP_Status_t IS25LP_ReadDeviceID( sIS25LP_Handle_t *handle, uint8_t *manufacturer, uint8_t *device_id )
-{
-    // Validate handle parameter
-    if( NULL == handle )
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_BLOCK_ERASE_32K ))
     {
         return IS25LP_ERROR;
     }
 
-    uint8_t cmd[6] = { CMD_READ_DEVICE_ID, 0x00, 0x00, 0x00, DUMMY_BYTE, DUMMY_BYTE };
-    uint8_t response[ 6 ];
-
-    SPI_CS_Low( handle );
-    if( HAL_OK != HAL_SPI_TransmitReceive( handle->spi_handle, cmd, response, sizeof(cmd), TIMEOUT_SPI ))
+    // Send erase command
+    if( IS25LP_OK != IS25LP_IssueErase( handle, IS25LP_ERASE_BLOCK_32K, address ))
     {
-        SPI_CS_High( handle );
         return IS25LP_ERROR;
     }
-    SPI_CS_High( handle );
 
-    *manufacturer = response[ 4 ];  // Manufacturer ID
-    *device_id = response[ 5 ];     // Device ID
+    // Wait for erase operation to complete
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_BLOCK_ERASE_32K ))
+    {
+        return IS25LP_ERROR;
+    }
 
     return IS25LP_OK;
 }
 
 /**
- * @brief  Read 64-bit Unique ID (0x4B command)
+ * @brief  Erase a 64KB block
  */
-eIS25LP_Status_t IS25LP_ReadUniqueID( sIS25LP_Handle_t *handle, uint8_t *unique_id )
+eIS25LP_Status_t IS25LP_EraseBlock64K( sIS25LP_Handle_t *handle, uint32_t address )
 {
     // Validate handle parameter
     if( NULL == handle )
@@ -227,51 +2743,85 @@ eIS25LP_Status_t IS25LP_ReadUniqueID( sIS25LP_Handle_t *handle, uint8_t *unique_
         return IS25LP_ERROR;
     }
 
-    uint8_t cmd[ 13 ] = { CMD_READ_UNIQUE_ID };
-    uint8_t response[ 13 ];
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
+    {
+        return IS25LP_ERROR;
+    }
 
-    // 4 Dummy Bytes + 8 Unique ID Bytes
-    for (int i = 1; i < 13; i++) {
-        cmd[i] = DUMMY_BYTE;
+    // Check address range
+    if( address >= IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Align address to 64KB block boundary
+    address = ( address / IS25LP_BLOCK_64K_SIZE ) * IS25LP_BLOCK_64K_SIZE;
+
+    // Nothing to do if the block is already erased
+    if( IS25LP_SkipErase( handle, address, IS25LP_BLOCK_64K_SIZE ))
+    {
+        return IS25LP_OK;
     }
 
-    SPI_CS_Low( handle );
-    if( HAL_OK != HAL_SPI_TransmitReceive( handle->spi_handle, cmd, response, sizeof(cmd), TIMEOUT_SPI ))
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_BLOCK_ERASE_64K ))
     {
-        SPI_CS_High( handle );
         return IS25LP_ERROR;
     }
-    SPI_CS_High( handle );
 
-    // Unique ID starts at byte 5 (after command + 4 dummy bytes)
-    memcpy( unique_id, &response[ 5 ], 8 );
+    // Send erase command
+    if( IS25LP_OK != IS25LP_IssueErase( handle, IS25LP_ERASE_BLOCK_64K, address ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Wait for erase operation to complete
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_BLOCK_ERASE_64K ))
+    {
+        return IS25LP_ERROR;
+    }
 
     return IS25LP_OK;
 }
 
 /**
- * @brief  Get Device Info
+ * @brief  Erase entire chip
  */
-eIS25LP_Status_t IS25LP_GetDeviceInfo( sIS25LP_Handle_t *handle, sIS25LP_DeviceInfo_t *info)
+eIS25LP_Status_t IS25LP_EraseChip( sIS25LP_Handle_t *handle )
 {
     // Validate handle parameter
-    if( NULL == handle || NULL == info )
+    if( NULL == handle )
     {
         return IS25LP_ERROR;
     }
 
-    if( !handle->initialized )
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
     {
         return IS25LP_ERROR;
     }
 
-    // Read device information
-    if( IS25LP_OK != IS25LP_ReadJedecID( handle, &info->manufacturer_id, &info->memory_type, &info->capacity ))
+    // Nothing to do if the chip is already erased
+    if( IS25LP_SkipErase( handle, 0, IS25LP_CHIP_SIZE ))
+    {
+        return IS25LP_OK;
+    }
+
+    // Wait for Flash to be ready
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_CHIP_ERASE ))
     {
         return IS25LP_ERROR;
     }
 
-    if( IS25LP_OK != IS25LP_ReadUniqueID( handle, info->unique_id ))
+    // Send erase command
+    if( IS25LP_OK != IS25LP_IssueErase( handle, IS25LP_ERASE_CHIP, 0 ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Wait for erase operation to complete (this takes several seconds!)
+    if( IS25LP_OK != IS25LP_WaitForReady( handle, IS25LP_OP_CHIP_ERASE ))
     {
         return IS25LP_ERROR;
     }
@@ -280,67 +2830,192 @@ eIS25LP_Status_t IS25LP_GetDeviceInfo( sIS25LP_Handle_t *handle, sIS25LP_DeviceI
 }
 
 /**
- * @brief  Read data from Flash memory
+ * @brief  Expected busy time of an operation: learned average, datasheet typical before warm-up
  */
-eIS25LP_Status_t IS25LP_Read( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+static uint32_t IS25LP_EstimateUs( sIS25LP_Handle_t *handle, eIS25LP_Operation_t op )
+{
+    const sIS25LP_TimingStats_t *stats = &handle->timing.stats[ op ];
+
+    return ( stats->count >= IS25LP_PREDICTOR_WARMUP ) ? stats->avg_us : s_op_typical_us[ op ];
+}
+
+/**
+ * @brief  Run one erase command and wait for it
+ */
+static eIS25LP_Status_t IS25LP_EraseBlocking( sIS25LP_Handle_t *handle, eIS25LP_EraseType_t type, uint32_t address )
+{
+    eIS25LP_Operation_t op = s_erase_ops[ type ].op;
+
+    if(( IS25LP_OK != IS25LP_WaitForReady( handle, op ))
+        || ( IS25LP_OK != IS25LP_IssueErase( handle, type, address ))
+        || ( IS25LP_OK != IS25LP_WaitForReady( handle, op )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Erase a sector-aligned range with the fastest mix of erase commands
+ */
+eIS25LP_Status_t IS25LP_EraseRange( sIS25LP_Handle_t *handle, uint32_t start, uint32_t length )
 {
+    uint32_t cost[ IS25LP_TOTAL_SECTORS + 1 ];          // Best time to erase sectors i..count-1
+    uint8_t choice[ IS25LP_TOTAL_SECTORS ];             // eIS25LP_EraseType_t starting at sector i
+    uint32_t span[ IS25LP_ERASE_CHIP ];                 // Sectors covered per erase type
+    uint32_t estimate[ IS25LP_ERASE_CHIP ];             // Expected busy time per erase type
+
     // Validate handle parameter
     if( NULL == handle )
     {
         return IS25LP_ERROR;
     }
 
-    // Validate parameters
-    if( NULL == buffer || 0 == length )
+    // Reject while an asynchronous operation owns the device
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Range must be sector aligned and inside the chip
+    if(( 0 == length ) || ( 0 != ( start % IS25LP_SECTOR_SIZE )) || ( 0 != ( length % IS25LP_SECTOR_SIZE ))
+        || (( start + length ) > IS25LP_CHIP_SIZE ))
     {
         return IS25LP_ERROR;
     }
 
-    // Check address range
-    if(( address + length ) > IS25LP_CHIP_SIZE )
+    uint32_t first = start / IS25LP_SECTOR_SIZE;
+    uint32_t count = length / IS25LP_SECTOR_SIZE;
+
+    for( uint32_t type = IS25LP_ERASE_SECTOR; type < IS25LP_ERASE_CHIP; type++ )
+    {
+        span[ type ] = s_erase_ops[ type ].size / IS25LP_SECTOR_SIZE;
+        estimate[ type ] = IS25LP_EstimateUs( handle, s_erase_ops[ type ].op );
+    }
+
+    // Plan backwards: at each sector take the cheapest aligned erase that stays inside the range
+    cost[ count ] = 0;
+
+    for( uint32_t i = count; i-- > 0; )
+    {
+        cost[ i ] = UINT32_MAX;
+
+        // Blank sectors may be left out (or covered by a block erase if that is cheaper)
+        if( handle->erase_skip_blank && IS25LP_IsBlank( handle, ( first + i ) * IS25LP_SECTOR_SIZE, IS25LP_SECTOR_SIZE ))
+        {
+            cost[ i ] = cost[ i + 1 ];
+            choice[ i ] = ERASE_SKIP;
+        }
+
+        for( uint32_t type = IS25LP_ERASE_SECTOR; type < IS25LP_ERASE_CHIP; type++ )
+        {
+            if(( 0 != (( first + i ) % span[ type ] )) || (( i + span[ type ] ) > count ))
+            {
+                continue;
+            }
+
+            uint32_t total = estimate[ type ] + cost[ i + span[ type ]];
+
+            if( total < cost[ i ] )
+            {
+                cost[ i ] = total;
+                choice[ i ] = ( uint8_t )type;
+            }
+        }
+    }
+
+    // Nothing left to erase
+    if( 0 == cost[ 0 ] )
+    {
+        return IS25LP_OK;
+    }
+
+    // Whole device: chip erase if it is expected to be faster
+    if(( IS25LP_TOTAL_SECTORS == count ) && ( IS25LP_EstimateUs( handle, IS25LP_OP_CHIP_ERASE ) < cost[ 0 ] ))
+    {
+        return IS25LP_EraseBlocking( handle, IS25LP_ERASE_CHIP, 0 );
+    }
+
+    for( uint32_t i = 0; i < count; i += ( ERASE_SKIP == choice[ i ] ) ? 1 : span[ choice[ i ]] )
+    {
+        if( ERASE_SKIP == choice[ i ] )
+        {
+            continue;
+        }
+
+        if( IS25LP_OK != IS25LP_EraseBlocking( handle, ( eIS25LP_EraseType_t )choice[ i ], ( first + i ) * IS25LP_SECTOR_SIZE ))
+        {
+            return IS25LP_ERROR;
+        }
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Issue the next page of an asynchronous write
+ */
+static eIS25LP_Status_t IS25LP_AsyncProgramNext( sIS25LP_Handle_t *handle )
+{
+    // Write only up to page boundary
+    uint32_t bytes_to_page_end = IS25LP_PAGE_SIZE - ( handle->async.address % IS25LP_PAGE_SIZE );
+    uint32_t bytes_to_write = handle->async.remaining;
+
+    if( bytes_to_write > bytes_to_page_end )
     {
-        return IS25LP_ERROR;
+        bytes_to_write = bytes_to_page_end;
     }
 
-    // Wait for Flash to be ready
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_SPI ))
+    if( IS25LP_OK != IS25LP_IssuePageProgram( handle, handle->async.address, handle->async.buffer, bytes_to_write ))
     {
         return IS25LP_ERROR;
     }
 
-    // Prepare command: [CMD][Address High][Address Mid][Address Low]
-    uint8_t cmd[ 4 ] = {
-        CMD_READ_DATA,
-        ( uint8_t )(( address >> 16 ) & 0xFF ),
-        ( uint8_t )(( address >> 8 ) & 0xFF ),
-        ( uint8_t )( address & 0xFF )
-    };
+    handle->async.address += bytes_to_write;
+    handle->async.buffer += bytes_to_write;
+    handle->async.remaining -= bytes_to_write;
+    handle->async.tickstart = HAL_GetTick( );
+    handle->async.timeout_ms = s_op_timeouts[ IS25LP_OP_PAGE_PROGRAM ];
 
-    SPI_CS_Low( handle );
+    return IS25LP_OK;
+}
 
-    // Send command and address
-    if( HAL_OK != HAL_SPI_Transmit( handle->spi_handle, cmd, sizeof(cmd), TIMEOUT_SPI ))
+/**
+ * @brief  Start an asynchronous read
+ */
+eIS25LP_Status_t IS25LP_ReadAsync( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context )
+{
+    // Validate handle parameter
+    if( NULL == handle )
     {
-        SPI_CS_High( handle );
         return IS25LP_ERROR;
     }
 
-    // Read data
-    if( HAL_OK != HAL_SPI_Receive( handle->spi_handle, buffer, length, TIMEOUT_SPI ))
+    // Only one operation at a time
+    if( IS25LP_ASYNC_IDLE != handle->async.state )
     {
-        SPI_CS_High( handle );
         return IS25LP_ERROR;
     }
 
-    SPI_CS_High( handle );
+    // Set state before starting, the DMA interrupt completes the read
+    handle->async.callback = callback;
+    handle->async.context = context;
+    handle->async.state = IS25LP_ASYNC_READ;
+
+    if( IS25LP_OK != IS25LP_StartReadDMA( handle, CMD_FAST_READ, address, buffer, length ))
+    {
+        handle->async.state = IS25LP_ASYNC_IDLE;
+        return IS25LP_ERROR;
+    }
 
     return IS25LP_OK;
 }
 
 /**
- * @brief  Fast read data from Flash memory
+ * @brief  Start an asynchronous multi-page write
  */
-eIS25LP_Status_t IS25LP_FastRead( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+eIS25LP_Status_t IS25LP_WriteAsync( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context )
 {
     // Validate handle parameter
     if( NULL == handle )
@@ -360,46 +3035,39 @@ eIS25LP_Status_t IS25LP_FastRead( sIS25LP_Handle_t *handle, uint32_t address, ui
         return IS25LP_ERROR;
     }
 
-    // Wait for Flash to be ready
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_SPI ))
+    // Only one operation at a time, let a background read (possibly of another chip) finish
+    if(( IS25LP_ASYNC_IDLE != handle->async.state ) || ( IS25LP_OK != IS25LP_DrainTransfer( handle )))
     {
         return IS25LP_ERROR;
     }
 
-    // Prepare command: [CMD][Address High][Address Mid][Address Low][Dummy]
-    uint8_t cmd[ 5 ] = {
-        CMD_FAST_READ,
-        ( uint8_t )(( address >> 16 ) & 0xFF ),
-        ( uint8_t )(( address >> 8 ) & 0xFF ),
-        ( uint8_t )( address & 0xFF ),
-        DUMMY_BYTE
-    };
-
-    SPI_CS_Low( handle );
-
-    // Send command, address, and dummy byte
-    if( HAL_OK != HAL_SPI_Transmit( handle->spi_handle, cmd, sizeof(cmd), TIMEOUT_SPI ))
+    // Flash must be idle, never block here
+    if( 0 != ( IS25LP_ReadStatusRegister( handle ) & STATUS_BUSY ))
     {
-        SPI_CS_High( handle );
         return IS25LP_ERROR;
     }
 
-    // Read data
-    if( HAL_OK != HAL_SPI_Receive( handle->spi_handle, buffer, length, TIMEOUT_SPI ))
+    handle->async.address = address;
+    handle->async.buffer = buffer;
+    handle->async.remaining = length;
+    handle->async.callback = callback;
+    handle->async.context = context;
+
+    // Issue first page, IS25LP_AsyncTick() continues
+    if( IS25LP_OK != IS25LP_AsyncProgramNext( handle ))
     {
-        SPI_CS_High( handle );
         return IS25LP_ERROR;
     }
 
-    SPI_CS_High( handle );
+    handle->async.state = IS25LP_ASYNC_PROGRAM;
 
     return IS25LP_OK;
 }
 
 /**
- * @brief  Write one page to Flash memory
+ * @brief  Start an asynchronous erase
  */
-eIS25LP_Status_t IS25LP_WritePage( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint16_t length )
+eIS25LP_Status_t IS25LP_EraseAsync( sIS25LP_Handle_t *handle, eIS25LP_EraseType_t type, uint32_t address, IS25LP_Callback_t callback, void *context )
 {
     // Validate handle parameter
     if( NULL == handle )
@@ -408,7 +3076,7 @@ eIS25LP_Status_t IS25LP_WritePage( sIS25LP_Handle_t *handle, uint32_t address, c
     }
 
     // Validate parameters
-    if( NULL == buffer || 0 == length || length > IS25LP_PAGE_SIZE )
+    if( type > IS25LP_ERASE_CHIP )
     {
         return IS25LP_ERROR;
     }
@@ -419,119 +3087,121 @@ eIS25LP_Status_t IS25LP_WritePage( sIS25LP_Handle_t *handle, uint32_t address, c
         return IS25LP_ERROR;
     }
 
-    // Ensure write does not cross page boundary
-    uint32_t page_offset = address % IS25LP_PAGE_SIZE;
-    if(( page_offset + length ) > IS25LP_PAGE_SIZE )
+    // Only one operation at a time, let a background read (possibly of another chip) finish
+    if(( IS25LP_ASYNC_IDLE != handle->async.state ) || ( IS25LP_OK != IS25LP_DrainTransfer( handle )))
     {
         return IS25LP_ERROR;
     }
 
-    // Wait for Flash to be ready
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_PAGE_PROGRAM ))
+    // Flash must be idle, never block here
+    if( 0 != ( IS25LP_ReadStatusRegister( handle ) & STATUS_BUSY ))
     {
         return IS25LP_ERROR;
     }
 
-    // Enable write operations
-    if( IS25LP_OK != IS25LP_WriteEnable( handle ))
+    // Send erase command (the device ignores the offset within the unit)
+    if( IS25LP_OK != IS25LP_IssueErase( handle, type, address ))
     {
         return IS25LP_ERROR;
     }
 
-    // Prepare command: [CMD][Address High][Address Mid][Address Low]
-    uint8_t cmd[ 4 ] = {
-        CMD_PAGE_PROGRAM,
-        ( uint8_t )(( address >> 16 ) & 0xFF ),
-        ( uint8_t )(( address >> 8 ) & 0xFF ),
-        ( uint8_t )( address & 0xFF )
-    };
+    handle->async.callback = callback;
+    handle->async.context = context;
+    handle->async.tickstart = HAL_GetTick( );
+    handle->async.timeout_ms = s_op_timeouts[ s_erase_ops[ type ].op ];
+    handle->async.state = IS25LP_ASYNC_ERASE;
 
-    SPI_CS_Low( handle );
+    return IS25LP_OK;
+}
 
-    // Send command and address
-    if( HAL_OK != HAL_SPI_Transmit( handle->spi_handle, cmd, sizeof(cmd), TIMEOUT_SPI ))
+/**
+ * @brief  Advance the asynchronous state machine (busy-poll tick)
+ */
+void IS25LP_AsyncTick( sIS25LP_Handle_t *handle )
+{
+    // A DMA read holds the bus (own reads are advanced from the interrupt), try again next tick
+    if(( NULL == handle ) || ( NULL != IS25LP_TransferOwner( handle )))
     {
-        SPI_CS_High( handle );
-        return IS25LP_ERROR;
+        return;
     }
 
-    // Write data
-    if( HAL_OK != HAL_SPI_Transmit( handle->spi_handle, ( uint8_t* )buffer, length, TIMEOUT_SPI ))
+#if IS25LP_WCACHE_LINES > 0
+    // Program one page that has waited too long per tick, only while no async operation runs
+    for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
     {
-        SPI_CS_High( handle );
-        return IS25LP_ERROR;
-    }
+        sIS25LP_CacheLine_t *line = &handle->wcache[ n ];
 
-    SPI_CS_High( handle );
+        if(( IS25LP_CACHE_INVALID != line->address ) && (( HAL_GetTick( ) - line->tick ) >= IS25LP_WCACHE_TIMEOUT_MS ))
+        {
+            line->due = true;
+        }
 
-    // Wait for write operation to complete
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_PAGE_PROGRAM ))
-    {
-        return IS25LP_ERROR;
+        if( line->due && ( IS25LP_CACHE_INVALID != line->address ) && ( IS25LP_ASYNC_IDLE == handle->async.state ))
+        {
+            // Failed: the page stays cached, retry after another timeout (IS25LP_Flush reports it)
+            if( IS25LP_OK != IS25LP_CacheFlushLine( handle, line ))
+            {
+                line->tick = HAL_GetTick( );
+                line->due = false;
+            }
+            break;
+        }
     }
+#endif
 
-    return IS25LP_OK;
-}
+    // DMA reads are advanced from the interrupt
+    eIS25LP_AsyncState_t state = handle->async.state;
 
-/**
- * @brief  Write data to Flash memory (multi-page)
- */
-eIS25LP_Status_t IS25LP_Write( sIS25LP_Handle_t *handle, uint32_t address, const uint8_t *buffer, uint32_t length )
-{
-    // Validate handle parameter
-    if( NULL == handle )
+    if((( IS25LP_ASYNC_PROGRAM != state ) && ( IS25LP_ASYNC_ERASE != state )) || handle->suspend.active )
     {
-        return IS25LP_ERROR;
+        return;
     }
 
-    // Validate parameters
-    if( NULL == buffer || 0 == length )
+    // Do not poll before the predicted completion
+    if(( IS25LP_GetMicros( ) - handle->timing.issue_us ) < IS25LP_PredictReadyUs( handle ))
     {
-        return IS25LP_ERROR;
+        return;
     }
 
-    // Check address range
-    if(( address + length ) > IS25LP_CHIP_SIZE )
+    // Still busy: only check the timeout
+    if( 0 != ( IS25LP_ReadStatusRegister( handle ) & STATUS_BUSY ))
     {
-        return IS25LP_ERROR;
+        if(( HAL_GetTick( ) - handle->async.tickstart ) > handle->async.timeout_ms )
+        {
+            IS25LP_AsyncComplete( handle, IS25LP_ERROR );
+        }
+        return;
     }
 
-    uint32_t bytes_written = 0;
-    uint32_t current_address = address;
-    const uint8_t *current_buffer = buffer;
-
-    while( bytes_written < length )
+    // Issue the next page of a multi-page write
+    if(( IS25LP_ASYNC_PROGRAM == state ) && ( handle->async.remaining > 0 ))
     {
-        // Calculate bytes remaining in current page
-        uint32_t page_offset = current_address % IS25LP_PAGE_SIZE;
-        uint32_t bytes_to_page_end = IS25LP_PAGE_SIZE - page_offset;
-        uint32_t bytes_to_write = ( length - bytes_written );
-
-        // Write only up to page boundary
-        if( bytes_to_write > bytes_to_page_end )
+        if( IS25LP_OK != IS25LP_AsyncProgramNext( handle ))
         {
-            bytes_to_write = bytes_to_page_end;
+            IS25LP_AsyncComplete( handle, IS25LP_ERROR );
         }
+        return;
+    }
 
-        // Write current page
-        if( IS25LP_OK != IS25LP_WritePage( handle, current_address, current_buffer, bytes_to_write ))
-        {
-            return IS25LP_ERROR;
-        }
+    // Tick-rate resolution is too coarse to feed the busy-time model
+    handle->timing.pending_op = IS25LP_OP_COUNT;
+    handle->device_idle = true;
 
-        // Update counters and pointers
-        bytes_written += bytes_to_write;
-        current_address += bytes_to_write;
-        current_buffer += bytes_to_write;
-    }
+    IS25LP_AsyncComplete( handle, IS25LP_OK );
+}
 
-    return IS25LP_OK;
+/**
+ * @brief  Check if an asynchronous operation is pending
+ */
+bool IS25LP_IsAsyncBusy( sIS25LP_Handle_t *handle )
+{
+    return ( NULL != handle ) && ( IS25LP_ASYNC_IDLE != handle->async.state );
 }
 
 /**
- * @brief  Erase a 4KB sector
+ * @brief  Suspend the running asynchronous program or erase
  */
-eIS25LP_Status_t IS25LP_EraseSector( sIS25LP_Handle_t *handle, uint32_t address )
+eIS25LP_Status_t IS25LP_Suspend( sIS25LP_Handle_t *handle )
 {
     // Validate handle parameter
     if( NULL == handle )
@@ -539,115 +3209,112 @@ eIS25LP_Status_t IS25LP_EraseSector( sIS25LP_Handle_t *handle, uint32_t address
         return IS25LP_ERROR;
     }
 
-    // Check address range
-    if( address >= IS25LP_CHIP_SIZE )
+    // Only a running program/erase can be suspended, chip erase excluded
+    if((( IS25LP_ASYNC_PROGRAM != handle->async.state ) && ( IS25LP_ASYNC_ERASE != handle->async.state ))
+        || handle->suspend.active || ( IS25LP_OP_CHIP_ERASE == handle->timing.pending_op ))
     {
         return IS25LP_ERROR;
     }
 
-    // Align address to sector boundary
-    address = ( address / IS25LP_SECTOR_SIZE ) * IS25LP_SECTOR_SIZE;
-
-    // Wait for Flash to be ready
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_SECTOR_ERASE ))
+    if( IS25LP_OK != IS25LP_DrainTransfer( handle ))
     {
         return IS25LP_ERROR;
     }
 
-    // Enable write operations
-    if( IS25LP_OK != IS25LP_WriteEnable( handle ))
+    // tRS: give the operation time to progress since the last resume
+    uint32_t since_resume = IS25LP_GetMicros( ) - handle->suspend.resume_us;
+
+    if( since_resume < TIME_RESUME_US )
     {
-        return IS25LP_ERROR;
+        IS25LP_DelayUs( TIME_RESUME_US - since_resume );
     }
 
-    // Prepare command: [CMD][Address High][Address Mid][Address Low]
-    uint8_t cmd[ 4 ] = {
-        CMD_SECTOR_ERASE,
-        ( uint8_t )(( address >> 16 ) & 0xFF ),
-        ( uint8_t )(( address >> 8 ) & 0xFF ),
-        ( uint8_t )( address & 0xFF )
-    };
+    uint8_t cmd = CMD_SUSPEND;
 
-    SPI_CS_Low( handle );
-    HAL_StatusTypeDef status = HAL_SPI_Transmit( handle->spi_handle, cmd, sizeof(cmd), TIMEOUT_SPI );
+    SPI_CS_Low( handle, CMD_SUSPEND );
+    eIS25LP_Status_t status = IS25LP_SPI_Transmit( handle, &cmd, sizeof(cmd) );
     SPI_CS_High( handle );
 
-    if( HAL_OK != status )
+    if( IS25LP_OK != status )
     {
         return IS25LP_ERROR;
     }
 
-    // Wait for erase operation to complete
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_SECTOR_ERASE ))
+    // tSUS: WIP drops once the array is readable
+    uint32_t start = IS25LP_GetMicros( );
+
+    while(( IS25LP_ReadStatusRegister( handle ) & STATUS_BUSY ) != 0 )
     {
-        return IS25LP_ERROR;
+        if(( IS25LP_GetMicros( ) - start ) > ( TIME_SUSPEND_US * TIMEOUT_MARGIN ))
+        {
+            // Did not stop in time: make sure it keeps running
+            handle->suspend.active = true;
+            handle->suspend.suspended = true;
+            handle->suspend.suspend_us = IS25LP_GetMicros( );
+            IS25LP_Resume( handle );
+            return IS25LP_ERROR;
+        }
     }
 
+    // The operation may have finished before the command arrived: nothing to resume then
+    handle->suspend.suspended = ( 0 != ( IS25LP_ReadFunctionRegister( handle ) & ( FUNCTION_PSUS | FUNCTION_ESUS )));
+    handle->suspend.suspend_us = IS25LP_GetMicros( );
+    handle->suspend.active = true;
+    handle->suspend.count++;
+
+    // Reads need no ready wait while suspended
+    handle->device_idle = true;
+
     return IS25LP_OK;
 }
 
 /**
- * @brief  Erase a 32KB block
+ * @brief  Resume a program or erase stopped by IS25LP_Suspend
  */
-eIS25LP_Status_t IS25LP_EraseBlock32K( sIS25LP_Handle_t *handle, uint32_t address )
+eIS25LP_Status_t IS25LP_Resume( sIS25LP_Handle_t *handle )
 {
     // Validate handle parameter
-    if( NULL == handle )
+    if( NULL == handle || !handle->suspend.active )
     {
         return IS25LP_ERROR;
     }
 
-    // Check address range
-    if( address >= IS25LP_CHIP_SIZE )
+    if( IS25LP_OK != IS25LP_DrainTransfer( handle ))
     {
         return IS25LP_ERROR;
     }
 
-    // Align address to 32KB block boundary
-    address = ( address / IS25LP_BLOCK_32K_SIZE ) * IS25LP_BLOCK_32K_SIZE;
-
-    // Wait for Flash to be ready
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_BLOCK_ERASE_32K ))
-    {
-        return IS25LP_ERROR;
-    }
+    handle->suspend.active = false;
 
-    // Enable write operations
-    if( IS25LP_OK != IS25LP_WriteEnable( handle ))
+    if( !handle->suspend.suspended )
     {
-        return IS25LP_ERROR;
+        // Completed on its own, IS25LP_AsyncTick() picks it up
+        return IS25LP_OK;
     }
 
-    // Prepare command: [CMD][Address High][Address Mid][Address Low]
-    uint8_t cmd[ 4 ] = {
-        CMD_BLOCK_ERASE_32K,
-        ( uint8_t )(( address >> 16 ) & 0xFF ),
-        ( uint8_t )(( address >> 8 ) & 0xFF ),
-        ( uint8_t )( address & 0xFF )
-    };
+    uint8_t cmd = CMD_RESUME;
 
-    SPI_CS_Low( handle );
-    HAL_StatusTypeDef status = HAL_SPI_Transmit( handle->spi_handle, cmd, sizeof(cmd), TIMEOUT_SPI );
+    SPI_CS_Low( handle, CMD_RESUME );
+    eIS25LP_Status_t status = IS25LP_SPI_Transmit( handle, &cmd, sizeof(cmd) );
     SPI_CS_High( handle );
 
-    if( HAL_OK != status )
-    {
-        return IS25LP_ERROR;
-    }
+    // Suspended time does not count as busy time
+    uint32_t now = IS25LP_GetMicros( );
+    uint32_t suspended_us = now - handle->suspend.suspend_us;
 
-    // Wait for erase operation to complete
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_BLOCK_ERASE_32K ))
-    {
-        return IS25LP_ERROR;
-    }
+    handle->timing.issue_us += suspended_us;
+    handle->async.tickstart += suspended_us / 1000;
+    handle->suspend.resume_us = now;
+    handle->suspend.suspended = false;
+    handle->device_idle = false;
 
-    return IS25LP_OK;
+    return status;
 }
 
 /**
- * @brief  Erase a 64KB block
+ * @brief  Configure the ready polling policy of an operation class
  */
-eIS25LP_Status_t IS25LP_EraseBlock64K( sIS25LP_Handle_t *handle, uint32_t address )
+eIS25LP_Status_t IS25LP_SetPollPolicy( sIS25LP_Handle_t *handle, eIS25LP_Operation_t op, eIS25LP_PollMode_t mode, uint32_t interval_us )
 {
     // Validate handle parameter
     if( NULL == handle )
@@ -655,92 +3322,165 @@ eIS25LP_Status_t IS25LP_EraseBlock64K( sIS25LP_Handle_t *handle, uint32_t addres
         return IS25LP_ERROR;
     }
 
-    // Check address range
-    if( address >= IS25LP_CHIP_SIZE )
+    // Validate parameters
+    if(( op >= IS25LP_OP_COUNT ) || ( mode > IS25LP_POLL_CONTINUOUS ))
     {
         return IS25LP_ERROR;
     }
 
-    // Align address to 64KB block boundary
-    address = ( address / IS25LP_BLOCK_64K_SIZE ) * IS25LP_BLOCK_64K_SIZE;
+    handle->poll[ op ].mode = mode;
+    handle->poll[ op ].interval_us = interval_us;
 
-    // Wait for Flash to be ready
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_BLOCK_ERASE_64K ))
-    {
-        return IS25LP_ERROR;
-    }
+    return IS25LP_OK;
+}
 
-    // Enable write operations
-    if( IS25LP_OK != IS25LP_WriteEnable( handle ))
+/**
+ * @brief  Get the learned busy-time statistics of an operation class
+ */
+eIS25LP_Status_t IS25LP_GetTimingStats( sIS25LP_Handle_t *handle, eIS25LP_Operation_t op, sIS25LP_TimingStats_t *stats )
+{
+    // Validate parameters
+    if( NULL == handle || NULL == stats || op >= IS25LP_OP_COUNT )
     {
         return IS25LP_ERROR;
     }
 
-    // Prepare command: [CMD][Address High][Address Mid][Address Low]
-    uint8_t cmd[ 4 ] = {
-        CMD_BLOCK_ERASE_64K,
-        ( uint8_t )(( address >> 16 ) & 0xFF ),
-        ( uint8_t )(( address >> 8 ) & 0xFF ),
-        ( uint8_t )( address & 0xFF )
-    };
+    *stats = handle->timing.stats[ op ];
 
-    SPI_CS_Low( handle );
-    HAL_StatusTypeDef status = HAL_SPI_Transmit( handle->spi_handle, cmd, sizeof(cmd), TIMEOUT_SPI );
-    SPI_CS_High( handle );
+    return IS25LP_OK;
+}
 
-    if( HAL_OK != status )
+/**
+ * @brief  Forget all learned busy-time statistics
+ */
+eIS25LP_Status_t IS25LP_ResetTimingStats( sIS25LP_Handle_t *handle )
+{
+    // Validate handle parameter
+    if( NULL == handle )
     {
         return IS25LP_ERROR;
     }
 
-    // Wait for erase operation to complete
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_BLOCK_ERASE_64K ))
+    memset( handle->timing.stats, 0, sizeof( handle->timing.stats ));
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Copy the instrumentation counters
+ */
+eIS25LP_Status_t IS25LP_GetStats( sIS25LP_Handle_t *handle, sIS25LP_Stats_t *snapshot )
+{
+#if IS25LP_USE_STATS
+    // Validate parameters
+    if( NULL == handle || NULL == snapshot )
     {
         return IS25LP_ERROR;
     }
 
+    *snapshot = handle->stats;
+
     return IS25LP_OK;
+#else
+    ( void )handle;
+    ( void )snapshot;
+    return IS25LP_ERROR;
+#endif
 }
 
 /**
- * @brief  Erase entire chip
+ * @brief  Clear the instrumentation counters, a running transaction is still counted
  */
-eIS25LP_Status_t IS25LP_EraseChip( sIS25LP_Handle_t *handle )
+eIS25LP_Status_t IS25LP_ResetStats( sIS25LP_Handle_t *handle )
 {
+#if IS25LP_USE_STATS
     // Validate handle parameter
     if( NULL == handle )
     {
         return IS25LP_ERROR;
     }
 
-    // Wait for Flash to be ready
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_CHIP_ERASE ))
-    {
-        return IS25LP_ERROR;
-    }
+    memset( handle->stats.opcode, 0, sizeof( handle->stats.opcode ));
+    memset( handle->stats.wait, 0, sizeof( handle->stats.wait ));
 
-    // Enable write operations
-    if( IS25LP_OK != IS25LP_WriteEnable( handle ))
+    return IS25LP_OK;
+#else
+    ( void )handle;
+    return IS25LP_ERROR;
+#endif
+}
+
+/**
+ * @brief  Start or stop recording into the trace ring
+ */
+eIS25LP_Status_t IS25LP_TraceEnable( sIS25LP_Handle_t *handle, bool enable )
+{
+#if IS25LP_TRACE_ENTRIES > 0
+    // Validate handle parameter
+    if( NULL == handle )
     {
         return IS25LP_ERROR;
     }
 
-    uint8_t cmd = CMD_CHIP_ERASE;
+    handle->trace.enabled = enable;
 
-    SPI_CS_Low( handle );
-    HAL_StatusTypeDef status = HAL_SPI_Transmit( handle->spi_handle, &cmd, sizeof(cmd), TIMEOUT_SPI );
-    SPI_CS_High( handle );
+    return IS25LP_OK;
+#else
+    ( void )handle;
+    ( void )enable;
+    return IS25LP_ERROR;
+#endif
+}
 
-    if( HAL_OK != status )
+/**
+ * @brief  Discard all trace records
+ */
+eIS25LP_Status_t IS25LP_TraceClear( sIS25LP_Handle_t *handle )
+{
+#if IS25LP_TRACE_ENTRIES > 0
+    // Validate handle parameter, a DMA read may still commit its record
+    if(( NULL == handle ) || handle->trace.open )
     {
         return IS25LP_ERROR;
     }
 
-    // Wait for erase operation to complete (this takes several seconds!)
-    if( IS25LP_OK != IS25LP_WaitForReady( handle, TIMEOUT_CHIP_ERASE ))
+    handle->trace.head = 0;
+    memset( handle->trace.records, 0, sizeof( handle->trace.records ));
+
+    return IS25LP_OK;
+#else
+    ( void )handle;
+    return IS25LP_ERROR;
+#endif
+}
+
+/**
+ * @brief  Microsecond time base (SysTick interpolation, weak)
+ */
+__weak uint32_t IS25LP_GetMicros( void )
+{
+    uint32_t ms;
+    uint32_t ticks;
+    bool pending;
+
+    // Sample again if the millisecond tick advanced in between
+    do
     {
-        return IS25LP_ERROR;
+        ms = HAL_GetTick( );
+        ticks = SysTick->VAL;
+        pending = ( 0 != ( SCB->ICSR & SCB_ICSR_PENDSTSET_Msk ));
+    } while( ms != HAL_GetTick( ));
+
+    // Called above SysTick priority (DMA completion) after VAL wrapped: the
+    // tick count is one behind, VAL read again is certainly past the wrap
+    if( pending )
+    {
+        ticks = SysTick->VAL;
+        ms++;
     }
 
-    return IS25LP_OK;
+    // SysTick counts down from LOAD once per millisecond
+    uint32_t load = SysTick->LOAD + 1;
+
+    return ( ms * 1000 ) + ((( load - 1 - ticks ) * 1000 ) / load );
 }
@@ -0,0 +1,414 @@
+/**
+ * @file    is25lp040e_bench.c
+ * @brief   Source file for IS25LP040E driver benchmarks.
+ *          Implements latency measurements on top of the public driver API.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e_bench.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief   Seed of the address generator (same sequence for every variant)
+ */
+#define BENCH_SEED              0x12345678u
+
+/**
+ * @brief  Next pseudo-random number (LCG, Numerical Recipes constants)
+ */
+static uint32_t Bench_Random( uint32_t *state )
+{
+    *state = ( *state * 1664525u ) + 1013904223u;
+    return *state;
+}
+
+/**
+ * @brief  Run one variant of the small read benchmark
+ */
+static eIS25LP_Status_t Bench_SmallReadPass( sIS25LP_Handle_t *handle, uint32_t length, uint32_t iterations, bool force_poll, uint32_t *avg_us )
+{
+    uint8_t buffer[ IS25LP_PAGE_SIZE ];
+    uint32_t seed = BENCH_SEED;
+    uint32_t total_us = 0;
+
+    for( uint32_t i = 0; i < iterations; i++ )
+    {
+        uint32_t address = Bench_Random( &seed ) % ( IS25LP_CHIP_SIZE - length );
+
+        // Forget the idle state to get the previous always-poll behaviour
+        if( force_poll )
+        {
+            handle->device_idle = false;
+        }
+
+        uint32_t start = IS25LP_GetMicros( );
+
+        if( IS25LP_OK != IS25LP_Read( handle, address, buffer, length ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        total_us += IS25LP_GetMicros( ) - start;
+    }
+
+    *avg_us = total_us / iterations;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Measure small random read latency with and without idle tracking
+ */
+eIS25LP_Status_t IS25LP_Bench_SmallReadLatency( sIS25LP_Handle_t *handle, uint32_t length, uint32_t iterations, sIS25LP_BenchSmallRead_t *result )
+{
+    // Validate parameters
+    if( NULL == handle || NULL == result )
+    {
+        return IS25LP_ERROR;
+    }
+
+    if( 0 == length || length > IS25LP_PAGE_SIZE || 0 == iterations )
+    {
+        return IS25LP_ERROR;
+    }
+
+    result->length = length;
+    result->iterations = iterations;
+
+    if( IS25LP_OK != Bench_SmallReadPass( handle, length, iterations, true, &result->polled_avg_us ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    if( IS25LP_OK != Bench_SmallReadPass( handle, length, iterations, false, &result->idle_avg_us ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Compare IS25LP_EraseRange against a per-sector erase loop
+ */
+eIS25LP_Status_t IS25LP_Bench_EraseRange( sIS25LP_Handle_t *handle, uint32_t start, uint32_t length, sIS25LP_BenchEraseRange_t *result )
+{
+    // Validate parameters
+    if( NULL == handle || NULL == result )
+    {
+        return IS25LP_ERROR;
+    }
+
+    if( 0 == length || 0 != ( start % IS25LP_SECTOR_SIZE ) || 0 != ( length % IS25LP_SECTOR_SIZE ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    result->start = start;
+    result->length = length;
+
+    // Naive: one sector erase per 4KB
+    uint32_t begin = IS25LP_GetMicros( );
+
+    for( uint32_t address = start; address < ( start + length ); address += IS25LP_SECTOR_SIZE )
+    {
+        if( IS25LP_OK != IS25LP_EraseSector( handle, address ))
+        {
+            return IS25LP_ERROR;
+        }
+    }
+
+    result->naive_us = IS25LP_GetMicros( ) - begin;
+
+    // Planned mix of block and sector erases
+    begin = IS25LP_GetMicros( );
+
+    if( IS25LP_OK != IS25LP_EraseRange( handle, start, length ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    result->planned_us = IS25LP_GetMicros( ) - begin;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief   Benchmark suite operations
+ */
+typedef enum
+{
+    BENCH_READ = 0,
+    BENCH_FAST_READ,
+    BENCH_WRITE_PAGE,
+    BENCH_WRITE,
+    BENCH_ERASE_SECTOR,
+    BENCH_ERASE_32K,
+    BENCH_ERASE_64K,
+    BENCH_ERASE_CHIP,
+    BENCH_OP_COUNT
+} eBench_Op_t;
+
+typedef enum
+{
+    BENCH_SEQUENTIAL = 0,
+    BENCH_RANDOM,
+    BENCH_STRIDED,
+    BENCH_PATTERN_COUNT
+} eBench_Pattern_t;
+
+static const struct
+{
+    const char *name;
+    uint8_t overhead;           // Bytes on the wire besides the payload (opcode, address, dummy, WREN)
+    bool fast_clock;            // Runs at the fast read clock (everything but 0x03)
+} s_bench_ops[ BENCH_OP_COUNT ] = {
+    [ BENCH_READ ]         = { "read",         4, false },
+    [ BENCH_FAST_READ ]    = { "fast_read",    5, true },
+    [ BENCH_WRITE_PAGE ]   = { "write_page",   5, true },
+    [ BENCH_WRITE ]        = { "write",        5, true },
+    [ BENCH_ERASE_SECTOR ] = { "erase_sector", 5, true },
+    [ BENCH_ERASE_32K ]    = { "erase_32k",    5, true },
+    [ BENCH_ERASE_64K ]    = { "erase_64k",    5, true },
+    [ BENCH_ERASE_CHIP ]   = { "erase_chip",   2, true }
+};
+
+static const char *const s_bench_patterns[ BENCH_PATTERN_COUNT ] = { "sequential", "random", "strided" };
+
+static const uint32_t s_read_sizes[] = { 1, 16, 64, 256, 1024, 4096 };
+static const uint32_t s_page_sizes[] = { 1, 16, 64, 256 };
+static const uint32_t s_write_sizes[] = { 16, 256, 1024, 4096 };
+static const uint32_t s_aligns[] = { 0, 1 };
+
+static uint8_t s_bench_buffer[ IS25LP_SECTOR_SIZE + 1 ];
+static uint32_t s_bench_samples[ IS25LP_BENCH_MAX_SAMPLES ];
+
+/**
+ * @brief  Address of iteration i inside the region
+ * @note   Random and strided accesses start on a page (plus align). WritePage
+ *         uses page granularity for every pattern so it never crosses a page.
+ */
+static uint32_t Bench_Address( const sIS25LP_BenchSuite_t *config, eBench_Op_t op, eBench_Pattern_t pattern, uint32_t i, uint32_t size, uint32_t align, uint32_t *seed )
+{
+    uint32_t span = config->region_length - size - align;
+    uint32_t pages = span / IS25LP_PAGE_SIZE;
+    uint32_t offset;
+
+    switch( pattern )
+    {
+        case BENCH_RANDOM:
+            offset = ( Bench_Random( seed ) % pages ) * IS25LP_PAGE_SIZE;
+            break;
+
+        case BENCH_STRIDED:
+            offset = ( i * IS25LP_SECTOR_SIZE ) % ( pages * IS25LP_PAGE_SIZE );
+            break;
+
+        default:
+            offset = (( BENCH_WRITE_PAGE == op ) ? ( i * IS25LP_PAGE_SIZE ) : ( i * size )) % ( pages * IS25LP_PAGE_SIZE );
+            break;
+    }
+
+    return config->region_start + offset + align;
+}
+
+/**
+ * @brief  Run one operation of the suite
+ */
+static eIS25LP_Status_t Bench_Execute( sIS25LP_Handle_t *handle, eBench_Op_t op, uint32_t address, uint32_t size )
+{
+    switch( op )
+    {
+        case BENCH_READ:         return IS25LP_Read( handle, address, s_bench_buffer, size );
+        case BENCH_FAST_READ:    return IS25LP_FastRead( handle, address, s_bench_buffer, size );
+        case BENCH_WRITE_PAGE:   return IS25LP_WritePage( handle, address, s_bench_buffer, ( uint16_t )size );
+        case BENCH_WRITE:        return IS25LP_Write( handle, address, s_bench_buffer, size );
+        case BENCH_ERASE_SECTOR: return IS25LP_EraseSector( handle, address );
+        case BENCH_ERASE_32K:    return IS25LP_EraseBlock32K( handle, address );
+        case BENCH_ERASE_64K:    return IS25LP_EraseBlock64K( handle, address );
+        default:                 return IS25LP_EraseChip( handle );
+    }
+}
+
+/**
+ * @brief  Sort latency samples (insertion sort, n is small)
+ */
+static void Bench_Sort( uint32_t *samples, uint32_t count )
+{
+    for( uint32_t i = 1; i < count; i++ )
+    {
+        uint32_t value = samples[ i ];
+        uint32_t j = i;
+
+        while(( j > 0 ) && ( samples[ j - 1 ] > value ))
+        {
+            samples[ j ] = samples[ j - 1 ];
+            j--;
+        }
+
+        samples[ j ] = value;
+    }
+}
+
+/**
+ * @brief  Time one case and emit its CSV line
+ */
+static eIS25LP_Status_t Bench_Case( sIS25LP_Handle_t *handle, const sIS25LP_BenchSuite_t *config, eBench_Op_t op, eBench_Pattern_t pattern,
+                                    uint32_t size, uint32_t align, uint32_t iterations, IS25LP_BenchEmit_t emit, void *context )
+{
+    uint32_t seed = BENCH_SEED;
+    uint32_t total_us = 0;
+    char line[ 96 ];
+
+    // Programs need erased flash, prepared outside the measurement
+    if(( BENCH_WRITE_PAGE == op ) || ( BENCH_WRITE == op ))
+    {
+        if( IS25LP_OK != IS25LP_EraseRange( handle, config->region_start, config->region_length ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        // Read cases leave erased data behind, IS25LP_Write would skip all-0xFF pages
+        for( uint32_t i = 0; i < sizeof( s_bench_buffer ); i++ )
+        {
+            s_bench_buffer[ i ] = ( uint8_t )( 0x5A ^ i );
+        }
+    }
+
+    for( uint32_t i = 0; i < iterations; i++ )
+    {
+        uint32_t address;
+
+        if( op >= BENCH_ERASE_SECTOR )
+        {
+            address = config->region_start + (( i * size ) % config->region_length );
+        }
+        else
+        {
+            address = Bench_Address( config, op, pattern, i, size, align, &seed );
+        }
+
+        uint32_t start = IS25LP_GetMicros( );
+
+        if( IS25LP_OK != Bench_Execute( handle, op, address, size ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        s_bench_samples[ i ] = IS25LP_GetMicros( ) - start;
+        total_us += s_bench_samples[ i ];
+    }
+
+    // Any pending cached write belongs to this case, counted in the throughput
+    uint32_t start = IS25LP_GetMicros( );
+
+    if( IS25LP_OK != IS25LP_Flush( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    total_us += IS25LP_GetMicros( ) - start;
+
+    Bench_Sort( s_bench_samples, iterations );
+
+    if( 0 == total_us )
+    {
+        total_us = 1;
+    }
+
+    // Wire time at the opcode's calibrated clock, divider is 2^(BR+1)
+    uint32_t prescaler = s_bench_ops[ op ].fast_clock ? handle->clock.fast_prescaler : handle->clock.read_prescaler;
+    uint32_t spi_hz = HAL_RCC_GetPCLK1Freq( ) >> ((( prescaler & SPI_CR1_BR ) >> SPI_CR1_BR_Pos ) + 1 );
+    uint32_t payload = ( op >= BENCH_ERASE_SECTOR ) ? 0 : size;
+    uint64_t wire_us = (( uint64_t )( payload + s_bench_ops[ op ].overhead ) * iterations * 8000000ULL ) / spi_hz;
+    uint64_t bytes = ( uint64_t )size * iterations;
+    uint32_t mb_s_x100 = ( uint32_t )(( bytes * 100 ) / total_us );     // bytes/us = MB/s
+    uint32_t bus_x10 = ( uint32_t )(( wire_us * 1000 ) / total_us );
+
+    snprintf( line, sizeof( line ), "%s,%s,%lu,%lu,%lu,%lu.%02lu,%lu,%lu,%lu.%lu",
+              s_bench_ops[ op ].name, s_bench_patterns[ pattern ], ( unsigned long )size, ( unsigned long )align,
+              ( unsigned long )iterations, ( unsigned long )( mb_s_x100 / 100 ), ( unsigned long )( mb_s_x100 % 100 ),
+              ( unsigned long )s_bench_samples[ iterations / 2 ], ( unsigned long )s_bench_samples[(( iterations * 99 ) - 1 ) / 100 ],
+              ( unsigned long )( bus_x10 / 10 ), ( unsigned long )( bus_x10 % 10 ));
+    emit( line, context );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Run the throughput/latency suite and emit CSV
+ */
+eIS25LP_Status_t IS25LP_Bench_Suite( sIS25LP_Handle_t *handle, const sIS25LP_BenchSuite_t *config, IS25LP_BenchEmit_t emit, void *context )
+{
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == config ) || ( NULL == emit ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    if(( 0 == config->iterations ) || ( config->iterations > IS25LP_BENCH_MAX_SAMPLES ) || ( config->region_length < IS25LP_BLOCK_64K_SIZE )
+        || ( 0 != ( config->region_start % IS25LP_BLOCK_64K_SIZE )) || ( 0 != ( config->region_length % IS25LP_BLOCK_64K_SIZE ))
+        || (( config->region_start + config->region_length ) > IS25LP_CHIP_SIZE ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    emit( "op,pattern,size,align,iterations,mb_s,p50_us,p99_us,bus_pct", context );
+
+    for( eBench_Op_t op = BENCH_READ; op <= BENCH_WRITE; op++ )
+    {
+        const uint32_t *sizes = ( BENCH_WRITE_PAGE == op ) ? s_page_sizes : ( BENCH_WRITE == op ) ? s_write_sizes : s_read_sizes;
+        uint32_t count = ( BENCH_WRITE_PAGE == op ) ? ( sizeof( s_page_sizes ) / sizeof( s_page_sizes[ 0 ] ))
+                       : ( BENCH_WRITE == op ) ? ( sizeof( s_write_sizes ) / sizeof( s_write_sizes[ 0 ] ))
+                       : ( sizeof( s_read_sizes ) / sizeof( s_read_sizes[ 0 ] ));
+
+        for( eBench_Pattern_t pattern = BENCH_SEQUENTIAL; pattern < BENCH_PATTERN_COUNT; pattern++ )
+        {
+            for( uint32_t n = 0; n < count; n++ )
+            {
+                for( uint32_t a = 0; a < ( sizeof( s_aligns ) / sizeof( s_aligns[ 0 ] )); a++ )
+                {
+                    // A page program cannot cross the page end
+                    if(( BENCH_WRITE_PAGE == op ) && (( sizes[ n ] + s_aligns[ a ] ) > IS25LP_PAGE_SIZE ))
+                    {
+                        continue;
+                    }
+
+                    if( IS25LP_OK != Bench_Case( handle, config, op, pattern, sizes[ n ], s_aligns[ a ], config->iterations, emit, context ))
+                    {
+                        return IS25LP_ERROR;
+                    }
+                }
+            }
+        }
+    }
+
+    // Erase units of the region, one pass each
+    static const uint32_t unit_sizes[] = { IS25LP_SECTOR_SIZE, IS25LP_BLOCK_32K_SIZE, IS25LP_BLOCK_64K_SIZE };
+
+    for( uint32_t n = 0; n < 3; n++ )
+    {
+        uint32_t units = config->region_length / unit_sizes[ n ];
+        uint32_t iterations = ( units < config->iterations ) ? units : config->iterations;
+
+        if( IS25LP_OK != Bench_Case( handle, config, ( eBench_Op_t )( BENCH_ERASE_SECTOR + n ), BENCH_SEQUENTIAL, unit_sizes[ n ], 0, iterations, emit, context ))
+        {
+            return IS25LP_ERROR;
+        }
+    }
+
+    if( config->chip_erase && ( IS25LP_OK != Bench_Case( handle, config, BENCH_ERASE_CHIP, BENCH_SEQUENTIAL, IS25LP_CHIP_SIZE, 0, 1, emit, context )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
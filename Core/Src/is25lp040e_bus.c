@@ -0,0 +1,396 @@
+/**
+ * @file    is25lp040e_bus.c
+ * @brief   Source file for the IS25LP040E multi-chip bus manager.
+ *          Implements the striped address space and parallel background
+ *          programs/erases of chips sharing one SPI.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ *
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e_bus.h"
+
+#include <string.h>
+
+/**
+ * @brief  Chip holding a bus address
+ */
+static inline uint32_t Bus_Chip( const sIS25LP_Bus_t *bus, uint32_t address )
+{
+    return ( address / IS25LP_BUS_STRIPE_SIZE ) % bus->count;
+}
+
+/**
+ * @brief  Address inside its chip of a bus address
+ */
+static inline uint32_t Bus_ChipAddress( const sIS25LP_Bus_t *bus, uint32_t address )
+{
+    return (( address / IS25LP_BUS_STRIPE_SIZE ) / bus->count ) * IS25LP_BUS_STRIPE_SIZE + ( address % IS25LP_BUS_STRIPE_SIZE );
+}
+
+/**
+ * @brief  First stripe at or after stripe that lies on chip n
+ */
+static inline uint32_t Bus_FirstStripe( const sIS25LP_Bus_t *bus, uint32_t stripe, uint32_t n )
+{
+    return stripe + (( n + bus->count - ( stripe % bus->count )) % bus->count );
+}
+
+/**
+ * @brief  Position of a handle on the bus, count if not attached
+ */
+static uint32_t Bus_Index( const sIS25LP_Bus_t *bus, const sIS25LP_Handle_t *handle )
+{
+    uint32_t n = 0;
+
+    while(( n < bus->count ) && ( handle != bus->chips[ n ] ))
+    {
+        n++;
+    }
+
+    return n;
+}
+
+static void Bus_ChipDone( sIS25LP_Handle_t *handle, eIS25LP_Status_t status, void *context );
+
+/**
+ * @brief  Start the next piece of the job of chip n
+ */
+static eIS25LP_Status_t Bus_StartPiece( sIS25LP_Bus_t *bus, uint32_t n )
+{
+    sIS25LP_BusJob_t *job = &bus->jobs[ n ];
+    sIS25LP_Handle_t *chip = bus->chips[ n ];
+
+    if( bus->erase )
+    {
+        // Largest unit aligned at next that fits the rest of the range
+        uint32_t remaining = job->end - job->next;
+        eIS25LP_EraseType_t type = IS25LP_ERASE_SECTOR;
+        uint32_t size = IS25LP_SECTOR_SIZE;
+
+        if(( 0 == ( job->next % IS25LP_BLOCK_64K_SIZE )) && ( remaining >= IS25LP_BLOCK_64K_SIZE ))
+        {
+            type = IS25LP_ERASE_BLOCK_64K;
+            size = IS25LP_BLOCK_64K_SIZE;
+        }
+        else if(( 0 == ( job->next % IS25LP_BLOCK_32K_SIZE )) && ( remaining >= IS25LP_BLOCK_32K_SIZE ))
+        {
+            type = IS25LP_ERASE_BLOCK_32K;
+            size = IS25LP_BLOCK_32K_SIZE;
+        }
+
+        if( IS25LP_OK != IS25LP_EraseAsync( chip, type, job->next, Bus_ChipDone, bus ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        job->next += size;
+        return IS25LP_OK;
+    }
+
+    // Write up to the end of the stripe, the next stripe of this chip is count stripes ahead
+    uint32_t stripe = job->next / IS25LP_BUS_STRIPE_SIZE;
+    uint32_t piece_end = ( stripe + 1 ) * IS25LP_BUS_STRIPE_SIZE;
+
+    if( piece_end > job->end )
+    {
+        piece_end = job->end;
+    }
+
+    if( IS25LP_OK != IS25LP_WriteAsync( chip, Bus_ChipAddress( bus, job->next ), bus->source + ( job->next - bus->start ), piece_end - job->next, Bus_ChipDone, bus ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    job->next = ( stripe + bus->count ) * IS25LP_BUS_STRIPE_SIZE;
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  A chip finished its share, report the operation once all are done
+ */
+static void Bus_Finish( sIS25LP_Bus_t *bus, uint32_t n )
+{
+    bus->jobs[ n ].running = false;
+    bus->pending--;
+
+    if(( 0 == bus->pending ) && ( NULL != bus->callback ))
+    {
+        bus->callback( bus, bus->status, bus->context );
+    }
+}
+
+/**
+ * @brief  Completion of one piece on one chip (IS25LP_Callback_t)
+ */
+static void Bus_ChipDone( sIS25LP_Handle_t *handle, eIS25LP_Status_t status, void *context )
+{
+    sIS25LP_Bus_t *bus = ( sIS25LP_Bus_t* )context;
+    uint32_t n = Bus_Index( bus, handle );
+
+    if(( n >= bus->count ) || !bus->jobs[ n ].running )
+    {
+        return;
+    }
+
+    // Continue with the next piece of this chip, a failed chip stops
+    if(( IS25LP_OK == status ) && ( bus->jobs[ n ].next < bus->jobs[ n ].end ))
+    {
+        if( IS25LP_OK == Bus_StartPiece( bus, n ))
+        {
+            return;
+        }
+    }
+
+    if(( IS25LP_OK != status ) || ( bus->jobs[ n ].next < bus->jobs[ n ].end ))
+    {
+        bus->status = IS25LP_ERROR;
+    }
+
+    Bus_Finish( bus, n );
+}
+
+/**
+ * @brief  Start the first piece on every chip with a share
+ */
+static eIS25LP_Status_t Bus_Launch( sIS25LP_Bus_t *bus )
+{
+    bus->pending = 0;
+
+    for( uint32_t n = 0; n < bus->count; n++ )
+    {
+        if( bus->jobs[ n ].running )
+        {
+            bus->pending++;
+        }
+    }
+
+    for( uint32_t n = 0; n < bus->count; n++ )
+    {
+        if( bus->jobs[ n ].running && ( IS25LP_OK != Bus_StartPiece( bus, n )))
+        {
+            bus->status = IS25LP_ERROR;
+            bus->jobs[ n ].running = false;
+            bus->pending--;
+        }
+    }
+
+    // Nothing started: no callback will follow
+    return ( 0 == bus->pending ) ? IS25LP_ERROR : IS25LP_OK;
+}
+
+/**
+ * @brief  Set up a bus
+ */
+eIS25LP_Status_t IS25LP_BusInit( sIS25LP_Bus_t *bus, SPI_HandleTypeDef *spi_handle )
+{
+    // Validate parameters
+    if( NULL == bus || NULL == spi_handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    memset( bus, 0, sizeof( *bus ));
+    bus->spi_handle = spi_handle;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Add a chip to the bus
+ */
+eIS25LP_Status_t IS25LP_BusAttach( sIS25LP_Bus_t *bus, sIS25LP_Handle_t *handle )
+{
+    // Validate parameters
+    if( NULL == bus || NULL == handle )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Each chip needs its own chip select, the stripe order must not change under a running operation
+    if(( bus->count >= IS25LP_BUS_MAX_CHIPS ) || ( bus->count >= IS25LP_MAX_INSTANCES )
+        || ( IS25LP_CS_GPIO != handle->cs_mode ) || ( 0 != bus->pending ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    handle->spi_handle = bus->spi_handle;
+    handle->shared_spi = true;
+
+    if( IS25LP_OK != IS25LP_Init( handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    bus->chips[ bus->count ] = handle;
+    bus->count++;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Size of the striped address space
+ */
+uint32_t IS25LP_BusSize( sIS25LP_Bus_t *bus )
+{
+    return ( NULL != bus ) ? ( bus->count * IS25LP_CHIP_SIZE ) : 0;
+}
+
+/**
+ * @brief  Read from the striped address space
+ */
+eIS25LP_Status_t IS25LP_BusRead( sIS25LP_Bus_t *bus, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Validate parameters
+    if( NULL == bus || NULL == buffer || 0 == length )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address >= IS25LP_BusSize( bus )) || ( length > ( IS25LP_BusSize( bus ) - address )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    while( length > 0 )
+    {
+        uint32_t chunk = IS25LP_BUS_STRIPE_SIZE - ( address % IS25LP_BUS_STRIPE_SIZE );
+
+        if( chunk > length )
+        {
+            chunk = length;
+        }
+
+        if( IS25LP_OK != IS25LP_FastRead( bus->chips[ Bus_Chip( bus, address ) ], Bus_ChipAddress( bus, address ), buffer, chunk ))
+        {
+            return IS25LP_ERROR;
+        }
+
+        address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Program a range of the striped address space in the background
+ */
+eIS25LP_Status_t IS25LP_BusWrite( sIS25LP_Bus_t *bus, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_BusCallback_t callback, void *context )
+{
+    // Validate parameters
+    if( NULL == bus || NULL == buffer || 0 == length || 0 != bus->pending )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address >= IS25LP_BusSize( bus )) || ( length > ( IS25LP_BusSize( bus ) - address )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint32_t end = address + length;
+    uint32_t stripe = address / IS25LP_BUS_STRIPE_SIZE;
+
+    bus->erase = false;
+    bus->source = buffer;
+    bus->start = address;
+    bus->status = IS25LP_OK;
+    bus->callback = callback;
+    bus->context = context;
+
+    // Each chip starts at its first stripe inside the range (the first one may be partial)
+    for( uint32_t n = 0; n < bus->count; n++ )
+    {
+        uint32_t first = Bus_FirstStripe( bus, stripe, n ) * IS25LP_BUS_STRIPE_SIZE;
+
+        bus->jobs[ n ].next = ( first > address ) ? first : address;
+        bus->jobs[ n ].end = end;
+        bus->jobs[ n ].running = ( bus->jobs[ n ].next < end );
+    }
+
+    return Bus_Launch( bus );
+}
+
+/**
+ * @brief  Erase a range of the striped address space in the background
+ */
+eIS25LP_Status_t IS25LP_BusErase( sIS25LP_Bus_t *bus, uint32_t address, uint32_t length, IS25LP_BusCallback_t callback, void *context )
+{
+    // Validate parameters
+    if( NULL == bus || 0 == length || 0 != bus->pending )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Whole stripes only
+    if(( 0 != ( address % IS25LP_BUS_STRIPE_SIZE )) || ( 0 != ( length % IS25LP_BUS_STRIPE_SIZE ))
+        || ( address >= IS25LP_BusSize( bus )) || ( length > ( IS25LP_BusSize( bus ) - address )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint32_t first = address / IS25LP_BUS_STRIPE_SIZE;
+    uint32_t last = ( address + length ) / IS25LP_BUS_STRIPE_SIZE;
+
+    bus->erase = true;
+    bus->source = NULL;
+    bus->start = address;
+    bus->status = IS25LP_OK;
+    bus->callback = callback;
+    bus->context = context;
+
+    // The stripes of one chip are consecutive inside that chip
+    for( uint32_t n = 0; n < bus->count; n++ )
+    {
+        uint32_t stripe = Bus_FirstStripe( bus, first, n );
+
+        bus->jobs[ n ].running = ( stripe < last );
+
+        if( bus->jobs[ n ].running )
+        {
+            uint32_t stripes = (( last - 1 - stripe ) / bus->count ) + 1;
+
+            bus->jobs[ n ].next = ( stripe / bus->count ) * IS25LP_BUS_STRIPE_SIZE;
+            bus->jobs[ n ].end = bus->jobs[ n ].next + ( stripes * IS25LP_BUS_STRIPE_SIZE );
+        }
+    }
+
+    return Bus_Launch( bus );
+}
+
+/**
+ * @brief  Advance the background operations of all chips
+ */
+void IS25LP_BusTick( sIS25LP_Bus_t *bus )
+{
+    if(( NULL == bus ) || ( 0 == bus->count ))
+    {
+        return;
+    }
+
+    uint32_t first = bus->next_tick;
+
+    // Rotate who polls first so no chip always waits behind the others
+    bus->next_tick = ( uint8_t )(( first + 1 ) % bus->count );
+
+    for( uint32_t i = 0; i < bus->count; i++ )
+    {
+        IS25LP_AsyncTick( bus->chips[ ( first + i ) % bus->count ] );
+    }
+}
+
+/**
+ * @brief  Check for a running bus operation
+ */
+bool IS25LP_BusIsBusy( sIS25LP_Bus_t *bus )
+{
+    return ( NULL != bus ) && ( 0 != bus->pending );
+}
@@ -0,0 +1,245 @@
+/**
+ * @file    is25lp040e_prefetch.c
+ * @brief   Source file for the IS25LP040E read-ahead layer.
+ *          Implements sequential detection and double-buffered DMA prefetch.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e_prefetch.h"
+
+#include <string.h>
+
+/**
+ * @brief  Wait for the running prefetch, the window is dropped on failure
+ */
+static eIS25LP_Status_t Prefetch_Complete( sIS25LP_Prefetch_t *prefetch )
+{
+    if( !prefetch->inflight )
+    {
+        return IS25LP_OK;
+    }
+
+    uint8_t other = prefetch->current ^ 1;
+
+    prefetch->inflight = false;
+
+    // Still running means the transfer in flight is ours. The bound scales with the
+    // window and the clock it is read at, a timeout fills in result as a failure.
+    if( !prefetch->result.done )
+    {
+        ( void )IS25LP_WaitTransfer( prefetch->handle, IS25LP_TransferTimeout( prefetch->handle, prefetch->length[ other ] ));
+    }
+
+    // Own result, not xfer.status: a blocking read may have waited for it and run since
+    if( !prefetch->result.done || ( IS25LP_OK != prefetch->result.status ))
+    {
+        prefetch->address[ other ] = IS25LP_PREFETCH_INVALID;
+        return IS25LP_ERROR;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Start the DMA of the window following the current one
+ */
+static void Prefetch_Start( sIS25LP_Prefetch_t *prefetch )
+{
+    uint8_t other = prefetch->current ^ 1;
+    uint32_t address = prefetch->address[ prefetch->current ] + prefetch->length[ prefetch->current ];
+    uint32_t length = prefetch->window_size;
+
+    if( prefetch->inflight || ( IS25LP_PREFETCH_INVALID == prefetch->address[ prefetch->current ] ) || ( address >= IS25LP_CHIP_SIZE ))
+    {
+        return;
+    }
+
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        length = IS25LP_CHIP_SIZE - address;
+    }
+
+    // Best effort: the bus may be busy with something else
+    if( IS25LP_OK == IS25LP_FastReadDMAResult( prefetch->handle, address, prefetch->buffer[ other ], length, &prefetch->result ))
+    {
+        prefetch->address[ other ] = address;
+        prefetch->length[ other ] = length;
+        prefetch->inflight = true;
+    }
+}
+
+/**
+ * @brief  Check if a window holds address
+ */
+static bool Prefetch_Contains( const sIS25LP_Prefetch_t *prefetch, uint8_t window, uint32_t address )
+{
+    return ( IS25LP_PREFETCH_INVALID != prefetch->address[ window ] )
+        && ( address >= prefetch->address[ window ] )
+        && ( address < ( prefetch->address[ window ] + prefetch->length[ window ] ));
+}
+
+/**
+ * @brief  Set up a read-ahead stream
+ */
+eIS25LP_Status_t IS25LP_PrefetchInit( sIS25LP_Prefetch_t *prefetch, sIS25LP_Handle_t *handle, uint8_t *buffer0, uint8_t *buffer1, uint32_t window_size )
+{
+    // Validate parameters
+    if(( NULL == prefetch ) || ( NULL == handle ) || ( NULL == buffer0 ) || ( NULL == buffer1 ) || ( 0 == window_size ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    memset( prefetch, 0, sizeof( *prefetch ));
+    prefetch->handle = handle;
+    prefetch->buffer[ 0 ] = buffer0;
+    prefetch->buffer[ 1 ] = buffer1;
+    prefetch->window_size = window_size;
+    prefetch->address[ 0 ] = IS25LP_PREFETCH_INVALID;
+    prefetch->address[ 1 ] = IS25LP_PREFETCH_INVALID;
+    prefetch->next = IS25LP_PREFETCH_INVALID;
+    prefetch->modify_count = handle->modify_count;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Stop read-ahead and drop the windows
+ */
+eIS25LP_Status_t IS25LP_PrefetchReset( sIS25LP_Prefetch_t *prefetch )
+{
+    // Validate parameters
+    if( NULL == prefetch )
+    {
+        return IS25LP_ERROR;
+    }
+
+    eIS25LP_Status_t status = Prefetch_Complete( prefetch );
+
+    prefetch->address[ 0 ] = IS25LP_PREFETCH_INVALID;
+    prefetch->address[ 1 ] = IS25LP_PREFETCH_INVALID;
+    prefetch->sequential = 0;
+    prefetch->modify_count = prefetch->handle->modify_count;
+
+    return status;
+}
+
+/**
+ * @brief  Read through the read-ahead stream
+ */
+eIS25LP_Status_t IS25LP_PrefetchRead( sIS25LP_Prefetch_t *prefetch, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Validate parameters
+    if(( NULL == prefetch ) || ( NULL == buffer ) || ( 0 == length ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Flash contents changed since the windows were read
+    if( prefetch->modify_count != prefetch->handle->modify_count )
+    {
+        IS25LP_PrefetchReset( prefetch );
+    }
+
+    // Sequential detection
+    prefetch->sequential = ( address == prefetch->next ) ? ( prefetch->sequential + 1 ) : 0;
+    prefetch->next = address + length;
+
+    while( length > 0 )
+    {
+        uint8_t window = prefetch->current;
+
+        if( !Prefetch_Contains( prefetch, window, address ))
+        {
+            if( prefetch->inflight && Prefetch_Contains( prefetch, window ^ 1, address ))
+            {
+                // Next window is on its way: wait and switch over
+                prefetch->stats.waits++;
+
+                if( IS25LP_OK != Prefetch_Complete( prefetch ))
+                {
+                    return IS25LP_ERROR;
+                }
+
+                prefetch->current ^= 1;
+                Prefetch_Start( prefetch );
+                continue;
+            }
+
+            if( !prefetch->inflight && Prefetch_Contains( prefetch, window ^ 1, address ))
+            {
+                prefetch->current ^= 1;
+                Prefetch_Start( prefetch );
+                continue;
+            }
+
+            prefetch->stats.misses++;
+
+            if( IS25LP_OK != Prefetch_Complete( prefetch ))
+            {
+                return IS25LP_ERROR;
+            }
+
+            // Random access: straight to the bus
+            if( prefetch->sequential < IS25LP_PREFETCH_TRIGGER )
+            {
+                return IS25LP_FastRead( prefetch->handle, address, buffer, length );
+            }
+
+            // Sequential: refill the current window synchronously from here
+            uint32_t fill = prefetch->window_size;
+
+            if(( address + fill ) > IS25LP_CHIP_SIZE )
+            {
+                fill = IS25LP_CHIP_SIZE - address;
+            }
+
+            prefetch->address[ window ] = IS25LP_PREFETCH_INVALID;
+
+            if( IS25LP_OK != IS25LP_FastRead( prefetch->handle, address, prefetch->buffer[ window ], fill ))
+            {
+                return IS25LP_ERROR;
+            }
+
+            prefetch->address[ window ] = address;
+            prefetch->length[ window ] = fill;
+        }
+        else
+        {
+            prefetch->stats.hits++;
+        }
+
+        uint32_t offset = address - prefetch->address[ window ];
+        uint32_t chunk = prefetch->length[ window ] - offset;
+
+        if( chunk > length )
+        {
+            chunk = length;
+        }
+
+        memcpy( buffer, &prefetch->buffer[ window ][ offset ], chunk );
+
+        address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    // Keep the next window coming while the caller consumes this one
+    if( prefetch->sequential >= IS25LP_PREFETCH_TRIGGER )
+    {
+        Prefetch_Start( prefetch );
+    }
+
+    return IS25LP_OK;
+}
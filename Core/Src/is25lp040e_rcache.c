@@ -0,0 +1,241 @@
+/**
+ * @file    is25lp040e_rcache.c
+ * @brief   Source file for the IS25LP040E read cache.
+ *          Implements line lookup, replacement and invalidation.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e_rcache.h"
+
+#include <string.h>
+
+/**
+ * @brief  Pick the line to refill: a free one, else by policy
+ */
+static uint32_t RCache_Victim( sIS25LP_ReadCache_t *cache )
+{
+    for( uint32_t i = 0; i < cache->lines; i++ )
+    {
+        if( IS25LP_RCACHE_INVALID == cache->tags[ i ].address )
+        {
+            return i;
+        }
+    }
+
+    cache->stats.evictions++;
+
+    if( IS25LP_RCACHE_CLOCK == cache->policy )
+    {
+        // Second chance: clear reference bits until an unreferenced line comes up
+        while( 0 != cache->tags[ cache->hand ].stamp )
+        {
+            cache->tags[ cache->hand ].stamp = 0;
+            cache->hand = ( cache->hand + 1 ) % cache->lines;
+        }
+
+        uint32_t victim = cache->hand;
+        cache->hand = ( cache->hand + 1 ) % cache->lines;
+
+        return victim;
+    }
+
+    uint32_t victim = 0;
+
+    for( uint32_t i = 1; i < cache->lines; i++ )
+    {
+        if(( cache->now - cache->tags[ i ].stamp ) > ( cache->now - cache->tags[ victim ].stamp ))
+        {
+            victim = i;
+        }
+    }
+
+    return victim;
+}
+
+/**
+ * @brief  Attach a read cache to a handle
+ */
+eIS25LP_Status_t IS25LP_ReadCacheInit( sIS25LP_Handle_t *handle, sIS25LP_ReadCache_t *cache, void *arena, uint32_t arena_size, uint32_t line_size, eIS25LP_RCachePolicy_t policy )
+{
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == cache ) || ( NULL == arena ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    if(( IS25LP_PAGE_SIZE != line_size ) && ( IS25LP_SECTOR_SIZE != line_size ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Tags need word alignment
+    uintptr_t base = (( uintptr_t )arena + 3U ) & ~( uintptr_t )3U;
+    uint32_t padding = ( uint32_t )( base - ( uintptr_t )arena );
+
+    if( arena_size <= padding )
+    {
+        return IS25LP_ERROR;
+    }
+
+    uint32_t usable = arena_size - padding;
+
+    memset( cache, 0, sizeof( *cache ));
+    cache->lines = usable / ( line_size + sizeof( sIS25LP_RCacheTag_t ));
+    cache->line_size = line_size;
+    cache->policy = policy;
+
+    if( 0 == cache->lines )
+    {
+        return IS25LP_ERROR;
+    }
+
+    cache->tags = ( sIS25LP_RCacheTag_t* )base;
+    cache->data = ( uint8_t* )( cache->tags + cache->lines );
+
+    for( uint32_t i = 0; i < cache->lines; i++ )
+    {
+        cache->tags[ i ].address = IS25LP_RCACHE_INVALID;
+        cache->tags[ i ].stamp = 0;
+    }
+
+    handle->rcache = cache;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Read through the cache
+ */
+eIS25LP_Status_t IS25LP_CachedRead( sIS25LP_Handle_t *handle, uint32_t address, uint8_t *buffer, uint32_t length )
+{
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == handle->rcache ) || ( NULL == buffer ) || ( 0 == length ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    // Check address range
+    if(( address + length ) > IS25LP_CHIP_SIZE )
+    {
+        return IS25LP_ERROR;
+    }
+
+    sIS25LP_ReadCache_t *cache = handle->rcache;
+
+    while( length > 0 )
+    {
+        uint32_t line_address = address & ~( cache->line_size - 1 );
+        uint32_t offset = address - line_address;
+        uint32_t chunk = cache->line_size - offset;
+        uint32_t line = cache->lines;
+
+        if( chunk > length )
+        {
+            chunk = length;
+        }
+
+        for( uint32_t i = 0; i < cache->lines; i++ )
+        {
+            if( line_address == cache->tags[ i ].address )
+            {
+                line = i;
+                break;
+            }
+        }
+
+        if( line < cache->lines )
+        {
+            cache->stats.hits++;
+        }
+        else
+        {
+            cache->stats.misses++;
+            line = RCache_Victim( cache );
+
+            // Tag is set only after a successful fill
+            cache->tags[ line ].address = IS25LP_RCACHE_INVALID;
+
+            if( IS25LP_OK != IS25LP_FastRead( handle, line_address, &cache->data[ line * cache->line_size ], cache->line_size ))
+            {
+                return IS25LP_ERROR;
+            }
+
+            cache->tags[ line ].address = line_address;
+        }
+
+        // LRU: time of use, CLOCK: reference bit
+        cache->tags[ line ].stamp = ( IS25LP_RCACHE_LRU == cache->policy ) ? ++cache->now : 1;
+
+        memcpy( buffer, &cache->data[ ( line * cache->line_size ) + offset ], chunk );
+
+        address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Drop cached lines overlapping a range
+ */
+void IS25LP_ReadCacheInvalidate( sIS25LP_Handle_t *handle, uint32_t address, uint32_t length )
+{
+    if(( NULL == handle ) || ( NULL == handle->rcache ) || ( 0 == length ))
+    {
+        return;
+    }
+
+    sIS25LP_ReadCache_t *cache = handle->rcache;
+
+    for( uint32_t i = 0; i < cache->lines; i++ )
+    {
+        uint32_t line_address = cache->tags[ i ].address;
+
+        if(( IS25LP_RCACHE_INVALID != line_address )
+            && ( line_address < ( address + length ))
+            && (( line_address + cache->line_size ) > address ))
+        {
+            cache->tags[ i ].address = IS25LP_RCACHE_INVALID;
+            cache->stats.invalidations++;
+        }
+    }
+}
+
+/**
+ * @brief  Get the read cache counters
+ */
+eIS25LP_Status_t IS25LP_GetReadCacheStats( sIS25LP_Handle_t *handle, sIS25LP_RCacheStats_t *stats )
+{
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == handle->rcache ) || ( NULL == stats ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    *stats = handle->rcache->stats;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Reset the read cache counters
+ */
+eIS25LP_Status_t IS25LP_ResetReadCacheStats( sIS25LP_Handle_t *handle )
+{
+    // Validate parameters
+    if(( NULL == handle ) || ( NULL == handle->rcache ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    memset( &handle->rcache->stats, 0, sizeof( handle->rcache->stats ));
+
+    return IS25LP_OK;
+}
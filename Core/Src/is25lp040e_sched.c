@@ -0,0 +1,480 @@
+/**
+ * @file    is25lp040e_sched.c
+ * @brief   Source file for the IS25LP040E request scheduler.
+ *          Implements prioritized queues with aging on a static request pool.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e_sched.h"
+
+#include <string.h>
+
+/**
+ * @brief  Take an entry from the pool
+ */
+static sIS25LP_Request_t *Sched_Alloc( sIS25LP_Scheduler_t *sched )
+{
+    sIS25LP_Request_t *request = sched->free_list;
+
+    if( NULL == request )
+    {
+        sched->stats.rejected++;
+        return NULL;
+    }
+
+    sched->free_list = request->next;
+    memset( request, 0, sizeof( *request ));
+
+    return request;
+}
+
+/**
+ * @brief  Return an entry to the pool
+ */
+static void Sched_Free( sIS25LP_Scheduler_t *sched, sIS25LP_Request_t *request )
+{
+    request->next = sched->free_list;
+    sched->free_list = request;
+}
+
+/**
+ * @brief  Append a request to its class queue
+ */
+static void Sched_Enqueue( sIS25LP_Scheduler_t *sched, sIS25LP_Request_t *request )
+{
+    eIS25LP_ReqClass_t req_class = request->req_class;
+
+    request->next = NULL;
+    request->enqueue_tick = HAL_GetTick( );
+    request->sequence = sched->sequence++;
+
+    if( NULL == sched->tail[ req_class ] )
+    {
+        sched->head[ req_class ] = request;
+    }
+    else
+    {
+        sched->tail[ req_class ]->next = request;
+    }
+
+    sched->tail[ req_class ] = request;
+}
+
+/**
+ * @brief  Remove the oldest request of a class
+ */
+static sIS25LP_Request_t *Sched_Dequeue( sIS25LP_Scheduler_t *sched, eIS25LP_ReqClass_t req_class )
+{
+    sIS25LP_Request_t *request = sched->head[ req_class ];
+
+    sched->head[ req_class ] = request->next;
+
+    if( NULL == sched->head[ req_class ] )
+    {
+        sched->tail[ req_class ] = NULL;
+    }
+
+    request->next = NULL;
+
+    return request;
+}
+
+/**
+ * @brief  Priority of a queued request including aging (lower is more urgent)
+ */
+static int32_t Sched_Priority( const sIS25LP_Scheduler_t *sched, const sIS25LP_Request_t *request )
+{
+    int32_t priority = sched->priority[ request->req_class ];
+
+    if( sched->aging_ms > 0 )
+    {
+        priority -= ( int32_t )(( HAL_GetTick( ) - request->enqueue_tick ) / sched->aging_ms );
+    }
+
+    return priority;
+}
+
+/**
+ * @brief  Flash range [start, end) a request reads or modifies
+ */
+static void Sched_Range( const sIS25LP_Request_t *request, uint32_t *start, uint32_t *end )
+{
+    uint32_t size;
+
+    if( IS25LP_REQ_ERASE != request->req_class )
+    {
+        *start = request->address;
+        *end = request->address + request->length;
+        return;
+    }
+
+    switch( request->erase_type )
+    {
+        case IS25LP_ERASE_SECTOR:       size = IS25LP_SECTOR_SIZE;      break;
+        case IS25LP_ERASE_BLOCK_32K:    size = IS25LP_BLOCK_32K_SIZE;   break;
+        case IS25LP_ERASE_BLOCK_64K:    size = IS25LP_BLOCK_64K_SIZE;   break;
+        default:                        size = IS25LP_CHIP_SIZE;        break;
+    }
+
+    *start = request->address & ~( size - 1 );
+    *end = *start + size;
+}
+
+/**
+ * @brief  Check if two requests must run in submission order
+ */
+static bool Sched_Depends( const sIS25LP_Request_t *a, const sIS25LP_Request_t *b )
+{
+    uint32_t a_start, a_end, b_start, b_end;
+
+    // Reads never change the array
+    if(( IS25LP_REQ_READ == a->req_class ) && ( IS25LP_REQ_READ == b->req_class ))
+    {
+        return false;
+    }
+
+    Sched_Range( a, &a_start, &a_end );
+    Sched_Range( b, &b_start, &b_end );
+
+    return ( a_start < b_end ) && ( b_start < a_end );
+}
+
+/**
+ * @brief  Check if a request has to wait for the running or an older queued request
+ */
+static bool Sched_Blocked( sIS25LP_Scheduler_t *sched, const sIS25LP_Request_t *request )
+{
+    if(( NULL != sched->active ) && Sched_Depends( sched->active, request ))
+    {
+        return true;
+    }
+
+    for( uint32_t c = 0; c < IS25LP_REQ_CLASS_COUNT; c++ )
+    {
+        for( const sIS25LP_Request_t *older = sched->head[ c ]; NULL != older; older = older->next )
+        {
+            // Queues are FIFO, the rest of this one is newer
+            if(( int32_t )( older->sequence - request->sequence ) >= 0 )
+            {
+                break;
+            }
+
+            if( Sched_Depends( older, request ))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  Report a finished request and release it
+ */
+static void Sched_Complete( sIS25LP_Scheduler_t *sched, sIS25LP_Request_t *request, eIS25LP_Status_t status )
+{
+    IS25LP_Callback_t callback = request->callback;
+    void *context = request->context;
+
+    sched->stats.completed[ request->req_class ]++;
+    Sched_Free( sched, request );
+
+    // Last, the callback may queue the next request
+    if( NULL != callback )
+    {
+        callback( sched->handle, status, context );
+    }
+}
+
+/**
+ * @brief  Completion of the running program/erase (from IS25LP_AsyncTick)
+ */
+static void Sched_AsyncDone( sIS25LP_Handle_t *handle, eIS25LP_Status_t status, void *context )
+{
+    sIS25LP_Scheduler_t *sched = ( sIS25LP_Scheduler_t * )context;
+    sIS25LP_Request_t *request = sched->active;
+
+    ( void )handle;
+
+    sched->active = NULL;
+
+    if( NULL != request )
+    {
+        Sched_Complete( sched, request, status );
+    }
+}
+
+/**
+ * @brief  Start a request on an idle device
+ */
+static void Sched_Start( sIS25LP_Scheduler_t *sched, sIS25LP_Request_t *request )
+{
+    eIS25LP_Status_t status;
+
+    switch( request->req_class )
+    {
+        case IS25LP_REQ_READ:
+            status = IS25LP_FastRead( sched->handle, request->address, request->destination, request->length );
+            Sched_Complete( sched, request, status );
+            return;
+
+        case IS25LP_REQ_PROGRAM:
+            sched->active = request;
+            status = IS25LP_WriteAsync( sched->handle, request->address, request->source, request->length, Sched_AsyncDone, sched );
+            break;
+
+        default:
+            sched->active = request;
+            status = IS25LP_EraseAsync( sched->handle, request->erase_type, request->address, Sched_AsyncDone, sched );
+            break;
+    }
+
+    if( IS25LP_OK != status )
+    {
+        sched->active = NULL;
+        Sched_Complete( sched, request, status );
+    }
+}
+
+/**
+ * @brief  Set up a scheduler for one handle
+ */
+eIS25LP_Status_t IS25LP_SchedInit( sIS25LP_Scheduler_t *sched, sIS25LP_Handle_t *handle )
+{
+    // Validate parameters
+    if(( NULL == sched ) || ( NULL == handle ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    memset( sched, 0, sizeof( *sched ));
+    sched->handle = handle;
+    sched->priority[ IS25LP_REQ_READ ] = 0;
+    sched->priority[ IS25LP_REQ_PROGRAM ] = 1;
+    sched->priority[ IS25LP_REQ_ERASE ] = 2;
+    sched->aging_ms = IS25LP_SCHED_AGING_MS;
+
+    for( uint32_t i = 0; i < IS25LP_SCHED_DEPTH; i++ )
+    {
+        Sched_Free( sched, &sched->pool[ i ] );
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Change the base priority of a request class
+ */
+eIS25LP_Status_t IS25LP_SchedSetPriority( sIS25LP_Scheduler_t *sched, eIS25LP_ReqClass_t req_class, uint8_t priority )
+{
+    // Validate parameters
+    if(( NULL == sched ) || ( req_class >= IS25LP_REQ_CLASS_COUNT ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    sched->priority[ req_class ] = priority;
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Queue a read
+ */
+eIS25LP_Status_t IS25LP_SchedRead( sIS25LP_Scheduler_t *sched, uint32_t address, uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context )
+{
+    // Validate parameters
+    if(( NULL == sched ) || ( NULL == buffer ) || ( 0 == length ) || (( address + length ) > IS25LP_CHIP_SIZE ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    sIS25LP_Request_t *request = Sched_Alloc( sched );
+
+    if( NULL == request )
+    {
+        return IS25LP_ERROR;
+    }
+
+    request->req_class = IS25LP_REQ_READ;
+    request->address = address;
+    request->destination = buffer;
+    request->length = length;
+    request->callback = callback;
+    request->context = context;
+    Sched_Enqueue( sched, request );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Queue a program
+ */
+eIS25LP_Status_t IS25LP_SchedWrite( sIS25LP_Scheduler_t *sched, uint32_t address, const uint8_t *buffer, uint32_t length, IS25LP_Callback_t callback, void *context )
+{
+    // Validate parameters
+    if(( NULL == sched ) || ( NULL == buffer ) || ( 0 == length ) || (( address + length ) > IS25LP_CHIP_SIZE ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    sIS25LP_Request_t *request = Sched_Alloc( sched );
+
+    if( NULL == request )
+    {
+        return IS25LP_ERROR;
+    }
+
+    request->req_class = IS25LP_REQ_PROGRAM;
+    request->address = address;
+    request->source = buffer;
+    request->length = length;
+    request->callback = callback;
+    request->context = context;
+    Sched_Enqueue( sched, request );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Queue an erase
+ */
+eIS25LP_Status_t IS25LP_SchedErase( sIS25LP_Scheduler_t *sched, eIS25LP_EraseType_t type, uint32_t address, IS25LP_Callback_t callback, void *context )
+{
+    // Validate parameters
+    if(( NULL == sched ) || ( type > IS25LP_ERASE_CHIP ) || ( address >= IS25LP_CHIP_SIZE ))
+    {
+        return IS25LP_ERROR;
+    }
+
+    sIS25LP_Request_t *request = Sched_Alloc( sched );
+
+    if( NULL == request )
+    {
+        return IS25LP_ERROR;
+    }
+
+    request->req_class = IS25LP_REQ_ERASE;
+    request->address = address;
+    request->erase_type = type;
+    request->callback = callback;
+    request->context = context;
+    Sched_Enqueue( sched, request );
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Run the scheduler
+ */
+void IS25LP_SchedTick( sIS25LP_Scheduler_t *sched )
+{
+    if( NULL == sched )
+    {
+        return;
+    }
+
+    // Advance the running program/erase, completion frees sched->active
+    IS25LP_AsyncTick( sched->handle );
+
+    if( NULL != sched->active )
+    {
+        int32_t running = sched->priority[ sched->active->req_class ];
+
+        // Reads that outrank the running operation are served during a suspend,
+        // unless they depend on it or on an older queued program/erase
+        while(( NULL != sched->head[ IS25LP_REQ_READ ] ) && ( Sched_Priority( sched, sched->head[ IS25LP_REQ_READ ] ) < running ))
+        {
+            sIS25LP_Request_t *request = sched->head[ IS25LP_REQ_READ ];
+
+            if( Sched_Blocked( sched, request ))
+            {
+                sched->stats.ordered++;
+                break;
+            }
+
+            // Rejected (no read_suspend, chip erase, busy unit): wait for completion
+            if( IS25LP_OK != IS25LP_FastRead( sched->handle, request->address, request->destination, request->length ))
+            {
+                break;
+            }
+
+            sched->stats.preempted++;
+            Sched_Complete( sched, Sched_Dequeue( sched, IS25LP_REQ_READ ), IS25LP_OK );
+        }
+
+        return;
+    }
+
+    // Device free: start the most urgent request, oldest class member first.
+    // The oldest request overall is never blocked, so something always starts.
+    int32_t best_priority = 0;
+    eIS25LP_ReqClass_t best = IS25LP_REQ_CLASS_COUNT;
+    eIS25LP_ReqClass_t base_best = IS25LP_REQ_CLASS_COUNT;
+
+    for( uint32_t c = 0; c < IS25LP_REQ_CLASS_COUNT; c++ )
+    {
+        if( NULL == sched->head[ c ] )
+        {
+            continue;
+        }
+
+        if( Sched_Blocked( sched, sched->head[ c ] ))
+        {
+            sched->stats.ordered++;
+            continue;
+        }
+
+        int32_t priority = Sched_Priority( sched, sched->head[ c ] );
+
+        if(( IS25LP_REQ_CLASS_COUNT == best ) || ( priority < best_priority ))
+        {
+            best = ( eIS25LP_ReqClass_t )c;
+            best_priority = priority;
+        }
+
+        if(( IS25LP_REQ_CLASS_COUNT == base_best ) || ( sched->priority[ c ] < sched->priority[ base_best ] ))
+        {
+            base_best = ( eIS25LP_ReqClass_t )c;
+        }
+    }
+
+    if( IS25LP_REQ_CLASS_COUNT == best )
+    {
+        return;
+    }
+
+    if( best != base_best )
+    {
+        sched->stats.aged++;
+    }
+
+    Sched_Start( sched, Sched_Dequeue( sched, best ));
+}
+
+/**
+ * @brief  Number of queued or running requests
+ */
+uint32_t IS25LP_SchedPending( sIS25LP_Scheduler_t *sched )
+{
+    uint32_t count = IS25LP_SCHED_DEPTH;
+
+    if( NULL == sched )
+    {
+        return 0;
+    }
+
+    for( sIS25LP_Request_t *request = sched->free_list; NULL != request; request = request->next )
+    {
+        count--;
+    }
+
+    return count;
+}
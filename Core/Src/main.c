@@ -18,6 +18,7 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "dma.h"
 #include "spi.h"
 #include "gpio.h"
 
@@ -36,6 +37,19 @@
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 
+// Last sector is reserved for the SPI clock calibration pattern
+#define FLASH_CAL_ADDRESS   ( IS25LP_CHIP_SIZE - IS25LP_SECTOR_SIZE )
+
+// 1: let calibration erase the last sector and write its pattern when missing (first boot)
+#ifndef FLASH_CAL_PROGRAM
+#define FLASH_CAL_PROGRAM   0
+#endif
+
+// 1: 64 MHz core and PCLK (SPI up to 32 MHz, the .ioc profile), 0: previous 32 MHz setup
+#ifndef SYSCLK_64MHZ
+#define SYSCLK_64MHZ        1
+#endif
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -92,6 +106,7 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_SPI1_Init();
   /* USER CODE BEGIN 2 */
 
@@ -99,6 +114,8 @@ int main(void)
   flash_handle.spi_handle = &hspi1;
   flash_handle.cs_gpio.port = SPI1_NSS_GPIO_Port;
   flash_handle.cs_gpio.pin = SPI1_NSS_Pin;
+  flash_handle.cs_mode = IS25LP_CS_GPIO;
+  flash_handle.read_suspend = true;
   flash_handle.wp_gpio.port = FLASH_WP_GPIO_Port;
   flash_handle.wp_gpio.pin = FLASH_WP_Pin;
   flash_handle.initialized = false;
@@ -108,6 +125,10 @@ int main(void)
   {
       // Flash initialized successfully
       flash_handle.initialized = true;
+
+      // Run each opcode at its fastest reliable SPI clock. Without the
+      // pattern (and FLASH_CAL_PROGRAM) the CubeMX prescaler stays in use.
+      ( void )IS25LP_CalibrateClock( &flash_handle, FLASH_CAL_ADDRESS, FLASH_CAL_PROGRAM );
   }
   else
   {
@@ -125,6 +146,9 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+
+    // Advance background Flash program/erase operations
+    IS25LP_AsyncTick( &flash_handle );
   }
   /* USER CODE END 3 */
 }
@@ -150,10 +174,18 @@ void SystemClock_Config(void)
   RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
   RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
   RCC_OscInitStruct.PLL.PLLM = RCC_PLLM_DIV1;
+#if SYSCLK_64MHZ
+  RCC_OscInitStruct.PLL.PLLN = 16;
+#else
   RCC_OscInitStruct.PLL.PLLN = 12;
+#endif
   RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
   RCC_OscInitStruct.PLL.PLLQ = RCC_PLLQ_DIV2;
+#if SYSCLK_64MHZ
+  RCC_OscInitStruct.PLL.PLLR = RCC_PLLR_DIV2;
+#else
   RCC_OscInitStruct.PLL.PLLR = RCC_PLLR_DIV3;
+#endif
   if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
   {
     Error_Handler();
@@ -167,7 +199,11 @@ void SystemClock_Config(void)
   RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
   RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
 
+#if SYSCLK_64MHZ
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+#else
   if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_1) != HAL_OK)
+#endif
   {
     Error_Handler();
   }
@@ -175,6 +211,28 @@ void SystemClock_Config(void)
 
 /* USER CODE BEGIN 4 */
 
+/**
+  * @brief  SPI TxRx transfer completed callback
+  * @param  hspi: SPI handle
+  * @retval None
+  */
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  // Chain/finish IS25LP DMA reads
+  IS25LP_SPI_TxRxCpltCallback( hspi );
+}
+
+/**
+  * @brief  SPI error callback
+  * @param  hspi: SPI handle
+  * @retval None
+  */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  // Abort IS25LP DMA reads
+  IS25LP_SPI_ErrorCallback( hspi );
+}
+
 /* USER CODE END 4 */
 
 /**
@@ -0,0 +1,63 @@
+/**
+ * @file    bench_main.c
+ * @brief   Host run of the IS25LP040E benchmark suite against the simulator.
+ *          Prints the suite CSV to stdout.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "sim_board.h"
+#include "is25lp040e_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static sIS25LP_Handle_t flash_handle;
+static sIS25LP_Sim_t flash_sim;
+
+static void Emit( const char *line, void *context )
+{
+    ( void )context;
+    printf( "%s\n", line );
+}
+
+/**
+ * @details Usage: sim_bench [iterations] [prescaler BR 0-7]
+ */
+int main( int argc, char **argv )
+{
+    uint32_t iterations = ( argc > 1 ) ? ( uint32_t )strtoul( argv[ 1 ], NULL, 0 ) : 32;
+    uint32_t br = ( argc > 2 ) ? ( uint32_t )strtoul( argv[ 2 ], NULL, 0 ) : 0;
+
+    if( IS25LP_OK != SimBoard_Init( &flash_handle, &flash_sim, IS25LP_CS_GPIO, ( br & 7 ) << SPI_CR1_BR_Pos ))
+    {
+        fprintf( stderr, "IS25LP_Init failed\n" );
+        return 1;
+    }
+
+    if( IS25LP_OK != IS25LP_CalibrateClock( &flash_handle, IS25LP_CHIP_SIZE - IS25LP_SECTOR_SIZE, true ))
+    {
+        fprintf( stderr, "IS25LP_CalibrateClock failed\n" );
+        return 1;
+    }
+
+    sIS25LP_BenchSuite_t config = {
+        .region_start = 0,
+        .region_length = 4 * IS25LP_BLOCK_64K_SIZE,
+        .iterations = iterations,
+        .chip_erase = true
+    };
+
+    if( IS25LP_OK != IS25LP_Bench_Suite( &flash_handle, &config, Emit, NULL ))
+    {
+        fprintf( stderr, "IS25LP_Bench_Suite failed\n" );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,437 @@
+/**
+ * @file    mock_hal.c
+ * @brief   Host implementation of the mocked STM32G0 HAL.
+ *          Virtual time base, GPIO/NSS chip select tracking and SPI bus
+ *          routing to simulated devices.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "stm32g0xx_hal.h"
+
+#include <string.h>
+
+#define NS_PER_MS           1000000ULL
+
+GPIO_TypeDef Mock_GPIOA, Mock_GPIOB, Mock_GPIOC, Mock_GPIOD;
+SPI_TypeDef Mock_SPI1, Mock_SPI2;
+DMA_Channel_TypeDef Mock_DMA1_Channel1, Mock_DMA1_Channel2, Mock_DMA1_Channel3, Mock_DMA1_Channel4;
+
+static sMock_Config_t s_config = {
+    .pclk_hz = 64000000,
+    .cpu_step_ns = 100,
+    .hal_overhead_ns = 3000,
+    .dma_overhead_ns = 2000
+};
+
+static uint64_t s_now_ns;
+static sMock_SpiDevice_t *s_devices;
+static sMock_BusStats_t s_stats;
+static SysTick_Type s_systick;
+static SCB_Type s_scb;
+static uint32_t s_tick_ms;          // Last millisecond the SysTick interrupt counted
+
+/**
+ * @brief   DMA transfer in flight: data is exchanged at start, completion fires at done_ns
+ */
+static struct
+{
+    SPI_HandleTypeDef *hspi;
+    uint64_t done_ns;
+    bool firing;
+} s_dma;
+
+/**
+ * @brief  SPI clock from the BR bits the driver programmed into CR1
+ */
+static uint32_t Mock_SpiHz( SPI_TypeDef *spi )
+{
+    uint32_t br = ( spi->CR1 & SPI_CR1_BR ) >> SPI_CR1_BR_Pos;
+
+    return s_config.pclk_hz >> ( br + 1 );
+}
+
+static uint64_t Mock_ByteNs( SPI_TypeDef *spi )
+{
+    return ( 8ULL * 1000000000ULL ) / Mock_SpiHz( spi );
+}
+
+static void Mock_SetSelected( sMock_SpiDevice_t *device, bool selected )
+{
+    if( device->selected != selected )
+    {
+        device->selected = selected;
+        device->select( device->context, selected );
+    }
+}
+
+/**
+ * @brief  Apply BSRR/BRR writes made since the last sample
+ * @note   Both registers written for one pin means a CS high/low pair. Starting
+ *         low it is the end of one transaction and the start of the next;
+ *         starting high it is an empty transaction, which the device ignores.
+ */
+static void Mock_SampleChipSelects( void )
+{
+    for( sMock_SpiDevice_t *device = s_devices; NULL != device; device = device->next )
+    {
+        GPIO_TypeDef *port = device->cs_port;
+
+        if( NULL == port )
+        {
+            continue;
+        }
+
+        bool rise = ( 0 != ( port->BSRR & device->cs_pin ));
+        bool fall = ( 0 != ( port->BRR & device->cs_pin ));
+
+        port->BSRR &= ~( uint32_t )device->cs_pin;
+        port->BRR &= ~( uint32_t )device->cs_pin;
+
+        if( rise )
+        {
+            port->ODR |= device->cs_pin;
+        }
+        if( fall )
+        {
+            port->ODR &= ~( uint32_t )device->cs_pin;
+        }
+
+        if( rise && fall )
+        {
+            if( device->selected )
+            {
+                Mock_SetSelected( device, false );
+                Mock_SetSelected( device, true );
+            }
+        }
+        else if( rise )
+        {
+            Mock_SetSelected( device, false );
+        }
+        else if( fall )
+        {
+            Mock_SetSelected( device, true );
+        }
+    }
+}
+
+/**
+ * @brief  Fire the DMA completion once virtual time has reached it
+ */
+static void Mock_ServiceDMA( void )
+{
+    if(( NULL == s_dma.hspi ) || s_dma.firing || ( s_now_ns < s_dma.done_ns ))
+    {
+        return;
+    }
+
+    SPI_HandleTypeDef *hspi = s_dma.hspi;
+
+    // Runs like the interrupt: the callback may start the next transfer
+    s_dma.hspi = NULL;
+    s_dma.firing = true;
+    HAL_SPI_TxRxCpltCallback( hspi );
+    s_dma.firing = false;
+}
+
+/**
+ * @brief  Host platform configuration
+ */
+sMock_Config_t *Mock_GetConfig( void )
+{
+    return &s_config;
+}
+
+/**
+ * @brief  Reset time, registers and attached devices
+ */
+void Mock_Reset( void )
+{
+    s_now_ns = 0;
+    s_tick_ms = 0;
+    s_devices = NULL;
+    memset( &s_stats, 0, sizeof( s_stats ));
+    memset( &s_dma, 0, sizeof( s_dma ));
+    memset( &Mock_GPIOA, 0, sizeof( GPIO_TypeDef ));
+    memset( &Mock_GPIOB, 0, sizeof( GPIO_TypeDef ));
+    memset( &Mock_GPIOC, 0, sizeof( GPIO_TypeDef ));
+    memset( &Mock_GPIOD, 0, sizeof( GPIO_TypeDef ));
+    memset( &Mock_SPI1, 0, sizeof( SPI_TypeDef ));
+    memset( &Mock_SPI2, 0, sizeof( SPI_TypeDef ));
+    Mock_DMA1_Channel1.CCR = DMA_CCR_MINC;
+    Mock_DMA1_Channel2.CCR = DMA_CCR_MINC;
+    Mock_DMA1_Channel3.CCR = DMA_CCR_MINC;
+    Mock_DMA1_Channel4.CCR = DMA_CCR_MINC;
+}
+
+/**
+ * @brief  Current virtual time
+ */
+uint64_t Mock_NowNs( void )
+{
+    return s_now_ns;
+}
+
+/**
+ * @brief  Let virtual time pass
+ */
+void Mock_AdvanceNs( uint64_t ns )
+{
+    Mock_SampleChipSelects( );
+    s_now_ns += ns;
+    Mock_ServiceDMA( );
+}
+
+/**
+ * @brief  Wire a simulated device to a bus
+ */
+void Mock_AttachDevice( sMock_SpiDevice_t *device )
+{
+    device->selected = false;
+    device->next = s_devices;
+    s_devices = device;
+}
+
+/**
+ * @brief  SPE change, drives NSS of devices without a GPIO chip select
+ */
+void Mock_SPI_SetEnable( SPI_TypeDef *spi, bool enable )
+{
+    Mock_SampleChipSelects( );
+
+    if( enable )
+    {
+        spi->CR1 |= SPI_CR1_SPE;
+    }
+    else
+    {
+        spi->CR1 &= ~SPI_CR1_SPE;
+        spi->rx_count = 0;
+    }
+
+    for( sMock_SpiDevice_t *device = s_devices; NULL != device; device = device->next )
+    {
+        if(( device->spi == spi ) && ( NULL == device->cs_port ))
+        {
+            Mock_SetSelected( device, enable );
+        }
+    }
+}
+
+/**
+ * @brief  Clock one byte: MOSI to every selected device, MISO from the selected one
+ */
+uint8_t Mock_SPI_Exchange( SPI_TypeDef *spi, uint8_t mosi )
+{
+    uint8_t miso = 0xFF;
+    uint32_t selected = 0;
+    uint32_t spi_hz = Mock_SpiHz( spi );
+
+    Mock_SampleChipSelects( );
+
+    for( sMock_SpiDevice_t *device = s_devices; NULL != device; device = device->next )
+    {
+        if(( device->spi == spi ) && device->selected )
+        {
+            miso &= device->exchange( device->context, mosi, spi_hz );
+            selected++;
+        }
+    }
+
+    if( selected > 1 )
+    {
+        s_stats.conflicts++;
+    }
+
+    s_stats.bytes++;
+    s_stats.busy_ns += Mock_ByteNs( spi );
+    Mock_AdvanceNs( Mock_ByteNs( spi ));
+
+    return miso;
+}
+
+/**
+ * @brief  Bus activity counters
+ */
+sMock_BusStats_t *Mock_GetBusStats( void )
+{
+    return &s_stats;
+}
+
+/**
+ * @brief  SysTick registers at the current virtual time (1 kHz tick)
+ */
+SysTick_Type *Mock_SysTick( void )
+{
+    uint32_t load = s_config.pclk_hz / 1000;
+
+    s_systick.LOAD = load - 1;
+    s_systick.VAL = ( load - 1 ) - ( uint32_t )((( s_now_ns % NS_PER_MS ) * load ) / NS_PER_MS );
+
+    return &s_systick;
+}
+
+/**
+ * @brief  System control block, PENDSTSET while a masked SysTick interrupt is waiting
+ */
+SCB_Type *Mock_SCB( void )
+{
+    bool pending = s_config.tick_masked && (( uint32_t )( s_now_ns / NS_PER_MS ) != s_tick_ms );
+
+    s_scb.ICSR = pending ? SCB_ICSR_PENDSTSET_Msk : 0;
+
+    return &s_scb;
+}
+
+/**
+ * @brief  Millisecond tick, every call costs one CPU step so polling loops advance
+ */
+uint32_t HAL_GetTick( void )
+{
+    Mock_AdvanceNs( s_config.cpu_step_ns );
+
+    // The counter only moves while the SysTick interrupt can run
+    if( !s_config.tick_masked )
+    {
+        s_tick_ms = ( uint32_t )( s_now_ns / NS_PER_MS );
+    }
+
+    return s_tick_ms;
+}
+
+void HAL_Delay( uint32_t Delay )
+{
+    // Same +1 tick as the HAL, the wait covers at least Delay full ticks
+    Mock_AdvanceNs(( uint64_t )( Delay + 1 ) * NS_PER_MS );
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq( void )
+{
+    return s_config.pclk_hz;
+}
+
+void HAL_GPIO_WritePin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState )
+{
+    if( GPIO_PIN_RESET != PinState )
+    {
+        GPIOx->BSRR = GPIO_Pin;
+    }
+    else
+    {
+        GPIOx->BRR = GPIO_Pin;
+    }
+
+    Mock_SampleChipSelects( );
+}
+
+GPIO_PinState HAL_GPIO_ReadPin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin )
+{
+    Mock_SampleChipSelects( );
+
+    return ( GPIOx->ODR & GPIO_Pin ) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive( SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout )
+{
+    ( void )Timeout;
+
+    if( NULL != s_dma.hspi )
+    {
+        return HAL_BUSY;
+    }
+
+    s_stats.hal_calls++;
+    Mock_AdvanceNs( s_config.hal_overhead_ns );
+    hspi->Instance->CR1 |= SPI_CR1_SPE;
+
+    for( uint16_t i = 0; i < Size; i++ )
+    {
+        uint8_t rx = Mock_SPI_Exchange( hspi->Instance, ( NULL != pTxData ) ? pTxData[ i ] : 0xFF );
+
+        if( NULL != pRxData )
+        {
+            pRxData[ i ] = rx;
+        }
+    }
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit( SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout )
+{
+    return HAL_SPI_TransmitReceive( hspi, pData, NULL, Size, Timeout );
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive( SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout )
+{
+    return HAL_SPI_TransmitReceive( hspi, NULL, pData, Size, Timeout );
+}
+
+/**
+ * @brief  DMA transfer: bytes move now, the completion callback fires after the wire time
+ */
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA( SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size )
+{
+    if(( NULL != s_dma.hspi ) || ( NULL == hspi->hdmatx ) || ( NULL == hspi->hdmarx ) || ( 0 == Size ))
+    {
+        return HAL_BUSY;
+    }
+
+    // TX advances only with memory increment set (the driver clears it to repeat one dummy byte)
+    bool tx_increment = ( 0 != ( hspi->hdmatx->Instance->CCR & DMA_CCR_MINC ));
+    uint64_t start_ns = s_now_ns;
+
+    s_stats.dma_transfers++;
+    hspi->Instance->CR1 |= SPI_CR1_SPE;
+    Mock_SampleChipSelects( );
+
+    for( uint16_t i = 0; i < Size; i++ )
+    {
+        uint8_t mosi = pTxData[ tx_increment ? i : 0 ];
+        uint8_t miso = 0xFF;
+
+        for( sMock_SpiDevice_t *device = s_devices; NULL != device; device = device->next )
+        {
+            if(( device->spi == hspi->Instance ) && device->selected )
+            {
+                miso &= device->exchange( device->context, mosi, Mock_SpiHz( hspi->Instance ));
+            }
+        }
+
+        pRxData[ i ] = miso;
+    }
+
+    s_stats.bytes += Size;
+    s_stats.busy_ns += Size * Mock_ByteNs( hspi->Instance );
+
+    s_dma.hspi = hspi;
+    s_dma.done_ns = start_ns + s_config.dma_overhead_ns + ( Size * Mock_ByteNs( hspi->Instance ));
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort( SPI_HandleTypeDef *hspi )
+{
+    if( s_dma.hspi == hspi )
+    {
+        s_dma.hspi = NULL;
+    }
+
+    return HAL_OK;
+}
+
+__weak void HAL_SPI_TxRxCpltCallback( SPI_HandleTypeDef *hspi )
+{
+    ( void )hspi;
+}
+
+__weak void HAL_SPI_ErrorCallback( SPI_HandleTypeDef *hspi )
+{
+    ( void )hspi;
+}
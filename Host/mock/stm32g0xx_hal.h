@@ -0,0 +1,266 @@
+/**
+ * @file    stm32g0xx_hal.h
+ * @brief   Host stand-in for the STM32G0 HAL.
+ *          Just the types, registers and functions the IS25LP driver uses,
+ *          backed by a virtual clock and simulated SPI devices (mock_hal.c).
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef MOCK_STM32G0XX_HAL_H_
+#define MOCK_STM32G0XX_HAL_H_
+
+/**
+ * @include necessary standard libraries
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define __weak                      __attribute__(( weak ))
+
+#define SET_BIT(REG, BIT)           (( REG ) |= ( BIT ))
+#define CLEAR_BIT(REG, BIT)         (( REG ) &= ~( BIT ))
+#define READ_BIT(REG, BIT)          (( REG ) & ( BIT ))
+#define WRITE_REG(REG, VAL)         (( REG ) = ( VAL ))
+#define READ_REG(REG)               (( REG ))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG(( REG ), ((( READ_REG( REG )) & ( ~( CLEARMASK ))) | ( SETMASK )))
+
+/**
+ * @brief   HAL status
+ */
+typedef enum
+{
+    HAL_OK = 0x00,
+    HAL_ERROR = 0x01,
+    HAL_BUSY = 0x02,
+    HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+/**
+ * @brief   Register blocks (layout as far as the driver touches them)
+ */
+typedef struct
+{
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[ 2 ];
+    volatile uint32_t BRR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SR;
+    volatile uint32_t DR;
+    uint8_t rx_fifo[ 4 ];           // Host only: bytes clocked in, not yet read from DR
+    uint8_t rx_count;               // Host only: fill level of rx_fifo
+} SPI_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CCR;
+    volatile uint32_t CNDTR;
+    volatile uint32_t CPAR;
+    volatile uint32_t CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct
+{
+    volatile uint32_t CPUID;
+    volatile uint32_t ICSR;
+} SCB_Type;
+
+/**
+ * @brief   Peripheral instances
+ */
+extern GPIO_TypeDef Mock_GPIOA, Mock_GPIOB, Mock_GPIOC, Mock_GPIOD;
+extern SPI_TypeDef Mock_SPI1, Mock_SPI2;
+extern DMA_Channel_TypeDef Mock_DMA1_Channel1, Mock_DMA1_Channel2, Mock_DMA1_Channel3, Mock_DMA1_Channel4;
+
+#define GPIOA                       ( &Mock_GPIOA )
+#define GPIOB                       ( &Mock_GPIOB )
+#define GPIOC                       ( &Mock_GPIOC )
+#define GPIOD                       ( &Mock_GPIOD )
+#define SPI1                        ( &Mock_SPI1 )
+#define SPI2                        ( &Mock_SPI2 )
+#define DMA1_Channel1               ( &Mock_DMA1_Channel1 )
+#define DMA1_Channel2               ( &Mock_DMA1_Channel2 )
+#define DMA1_Channel3               ( &Mock_DMA1_Channel3 )
+#define DMA1_Channel4               ( &Mock_DMA1_Channel4 )
+#define SysTick                     ( Mock_SysTick( ))
+#define SCB                         ( Mock_SCB( ))
+
+/**
+ * @brief   Register bits
+ */
+#define SCB_ICSR_PENDSTSET_Msk      ( 1UL << 26 )
+
+#define SPI_CR1_SPE                 ( 1UL << 6 )
+#define SPI_CR1_BR_Pos              3U
+#define SPI_CR1_BR                  ( 7UL << SPI_CR1_BR_Pos )
+#define SPI_SR_RXNE                 ( 1UL << 0 )
+#define SPI_SR_TXE                  ( 1UL << 1 )
+#define SPI_SR_BSY                  ( 1UL << 7 )
+#define SPI_SR_FRLVL                ( 3UL << 9 )
+#define SPI_SR_FTLVL                ( 3UL << 11 )
+
+#define SPI_BAUDRATEPRESCALER_2     ( 0UL << SPI_CR1_BR_Pos )
+#define SPI_BAUDRATEPRESCALER_4     ( 1UL << SPI_CR1_BR_Pos )
+#define SPI_BAUDRATEPRESCALER_8     ( 2UL << SPI_CR1_BR_Pos )
+#define SPI_BAUDRATEPRESCALER_16    ( 3UL << SPI_CR1_BR_Pos )
+#define SPI_BAUDRATEPRESCALER_32    ( 4UL << SPI_CR1_BR_Pos )
+#define SPI_BAUDRATEPRESCALER_64    ( 5UL << SPI_CR1_BR_Pos )
+#define SPI_BAUDRATEPRESCALER_128   ( 6UL << SPI_CR1_BR_Pos )
+#define SPI_BAUDRATEPRESCALER_256   ( 7UL << SPI_CR1_BR_Pos )
+
+#define DMA_CCR_EN                  ( 1UL << 0 )
+#define DMA_CCR_MINC                ( 1UL << 7 )
+
+#define GPIO_PIN_0                  (( uint16_t )0x0001 )
+#define GPIO_PIN_1                  (( uint16_t )0x0002 )
+#define GPIO_PIN_2                  (( uint16_t )0x0004 )
+#define GPIO_PIN_3                  (( uint16_t )0x0008 )
+#define GPIO_PIN_4                  (( uint16_t )0x0010 )
+#define GPIO_PIN_5                  (( uint16_t )0x0020 )
+#define GPIO_PIN_6                  (( uint16_t )0x0040 )
+#define GPIO_PIN_7                  (( uint16_t )0x0080 )
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+/**
+ * @brief   Handles
+ */
+typedef struct
+{
+    uint32_t Mode;
+    uint32_t Direction;
+    uint32_t DataSize;
+    uint32_t CLKPolarity;
+    uint32_t CLKPhase;
+    uint32_t NSS;
+    uint32_t BaudRatePrescaler;
+    uint32_t FirstBit;
+} SPI_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+    DMA_Channel_TypeDef *Instance;
+} DMA_HandleTypeDef;
+
+typedef struct __SPI_HandleTypeDef
+{
+    SPI_TypeDef *Instance;
+    SPI_InitTypeDef Init;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+} SPI_HandleTypeDef;
+
+/**
+ * @brief   Enabling the SPI asserts hardware NSS, so it goes through the bus model
+ */
+#define __HAL_SPI_ENABLE(__HANDLE__)    Mock_SPI_SetEnable(( __HANDLE__ )->Instance, true )
+#define __HAL_SPI_DISABLE(__HANDLE__)   Mock_SPI_SetEnable(( __HANDLE__ )->Instance, false )
+#define __HAL_DMA_DISABLE(__HANDLE__)   CLEAR_BIT(( __HANDLE__ )->Instance->CCR, DMA_CCR_EN )
+
+/**
+ * @brief   HAL functions
+ */
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+/**
+ * @struct sMock_Config_t
+ * @brief Host platform timing (see Mock_GetConfig)
+ */
+typedef struct
+{
+    uint32_t pclk_hz;               // SPI kernel clock, SPI clock = pclk_hz >> ( BR + 1 )
+    uint32_t cpu_step_ns;           // Virtual time charged per HAL_GetTick()/register poll
+    uint32_t hal_overhead_ns;       // Fixed cost of one blocking HAL SPI call
+    uint32_t dma_overhead_ns;       // Setup cost of one DMA transfer
+    bool tick_masked;               // Running above SysTick priority: HAL_GetTick() stalls, ICSR.PENDSTSET shows the missed tick
+} sMock_Config_t;
+
+/**
+ * @struct sMock_SpiDevice_t
+ * @brief A simulated SPI slave on a mock bus
+ * 
+ * @details cs_port NULL: the device sits on the hardware NSS of spi
+ *          (IS25LP_CS_HW_NSS). Otherwise chip select is sampled from the
+ *          BSRR/BRR writes of the driver each time virtual time advances,
+ *          which is before the next clocked byte and before any timing query.
+ */
+typedef struct sMock_SpiDevice
+{
+    SPI_TypeDef *spi;                                   // Bus the device is wired to
+    GPIO_TypeDef *cs_port;                              // Chip select port, NULL for hardware NSS
+    uint16_t cs_pin;                                    // Chip select pin mask
+    void ( *select )( void *context, bool selected );   // CS edge
+    uint8_t ( *exchange )( void *context, uint8_t mosi, uint32_t spi_hz );  // One byte while selected
+    void *context;                                      // Passed to the callbacks
+    bool selected;                                      // Current CS state (driver internal)
+    struct sMock_SpiDevice *next;                       // Next attached device (driver internal)
+} sMock_SpiDevice_t;
+
+/**
+ * @struct sMock_BusStats_t
+ * @brief Bus activity counters
+ */
+typedef struct
+{
+    uint64_t bytes;                 // Bytes clocked
+    uint64_t busy_ns;               // Time the SCK was running
+    uint32_t hal_calls;             // Blocking HAL transfers
+    uint32_t dma_transfers;         // DMA transfers started
+    uint32_t conflicts;             // Bytes clocked with more than one device selected
+} sMock_BusStats_t;
+
+/**
+ * @brief   Host platform control
+ */
+sMock_Config_t *Mock_GetConfig(void);
+void Mock_Reset(void);
+uint64_t Mock_NowNs(void);
+void Mock_AdvanceNs(uint64_t ns);
+void Mock_AttachDevice(sMock_SpiDevice_t *device);
+void Mock_SPI_SetEnable(SPI_TypeDef *spi, bool enable);
+uint8_t Mock_SPI_Exchange(SPI_TypeDef *spi, uint8_t mosi);
+sMock_BusStats_t *Mock_GetBusStats(void);
+SysTick_Type *Mock_SysTick(void);
+SCB_Type *Mock_SCB(void);
+
+#endif /* MOCK_STM32G0XX_HAL_H_ */
@@ -0,0 +1,69 @@
+/**
+ * @file    stm32g0xx_ll_spi.h
+ * @brief   Host stand-in for the STM32G0 LL SPI driver.
+ *          Register-level calls used by the IS25LP LL fast path.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef MOCK_STM32G0XX_LL_SPI_H_
+#define MOCK_STM32G0XX_LL_SPI_H_
+
+/**
+ * @include necessary headers
+ */
+#include "stm32g0xx_hal.h"
+
+static inline uint32_t LL_SPI_IsEnabled( SPI_TypeDef *SPIx )
+{
+    return ( SPIx->CR1 & SPI_CR1_SPE ) ? 1U : 0U;
+}
+
+static inline void LL_SPI_Enable( SPI_TypeDef *SPIx )
+{
+    Mock_SPI_SetEnable( SPIx, true );
+}
+
+// The shift register is modelled as blocking, TX is always free
+static inline uint32_t LL_SPI_IsActiveFlag_TXE( SPI_TypeDef *SPIx )
+{
+    ( void )SPIx;
+    return 1U;
+}
+
+static inline uint32_t LL_SPI_IsActiveFlag_RXNE( SPI_TypeDef *SPIx )
+{
+    return ( SPIx->rx_count > 0 ) ? 1U : 0U;
+}
+
+static inline void LL_SPI_TransmitData8( SPI_TypeDef *SPIx, uint8_t TxData )
+{
+    uint8_t rx = Mock_SPI_Exchange( SPIx, TxData );
+
+    if( SPIx->rx_count < sizeof( SPIx->rx_fifo ))
+    {
+        SPIx->rx_fifo[ SPIx->rx_count++ ] = rx;
+    }
+}
+
+static inline uint8_t LL_SPI_ReceiveData8( SPI_TypeDef *SPIx )
+{
+    uint8_t data = SPIx->rx_fifo[ 0 ];
+
+    if( 0 == SPIx->rx_count )
+    {
+        return 0xFF;
+    }
+
+    for( uint8_t i = 1; i < SPIx->rx_count; i++ )
+    {
+        SPIx->rx_fifo[ i - 1 ] = SPIx->rx_fifo[ i ];
+    }
+    SPIx->rx_count--;
+
+    return data;
+}
+
+#endif /* MOCK_STM32G0XX_LL_SPI_H_ */
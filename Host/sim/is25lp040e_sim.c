@@ -0,0 +1,519 @@
+/**
+ * @file    is25lp040e_sim.c
+ * @brief   Source file for the IS25LP040E behavioural model (host builds).
+ *          Implements the opcode set, AND-only programming, page wrap,
+ *          WEL/WIP, suspend/resume and deep power-down.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e_sim.h"
+
+#include <string.h>
+
+/**
+ * @brief   Opcodes
+ */
+#define OP_WRSR             0x01
+#define OP_PP               0x02
+#define OP_READ             0x03
+#define OP_WRDI             0x04
+#define OP_RDSR             0x05
+#define OP_WREN             0x06
+#define OP_FAST_READ        0x0B
+#define OP_SE               0x20
+#define OP_RDFR             0x48
+#define OP_RDUID            0x4B
+#define OP_BE32             0x52
+#define OP_CE_ALT           0x60
+#define OP_SUSPEND          0x75
+#define OP_RESUME           0x7A
+#define OP_RDMDID           0x90
+#define OP_RDJDID           0x9F
+#define OP_RDID             0xAB
+#define OP_SUSPEND_ALT      0xB0
+#define OP_DP               0xB9
+#define OP_CE               0xC7
+#define OP_BE64             0xD8
+#define OP_RESUME_ALT       0x30
+
+#define SR_WIP              0x01
+#define SR_WEL              0x02
+#define FR_PSUS             0x04
+#define FR_ESUS             0x08
+
+#define ID_MANUFACTURER     0x9D
+#define ID_MEMORY_TYPE      0x40
+#define ID_CAPACITY         0x13
+#define ID_DEVICE           0x12
+
+#define US                  1000ULL
+
+/**
+ * @brief  Complete the internal operation once its time is up
+ */
+static void Sim_Update( sIS25LP_Sim_t *sim )
+{
+    uint64_t now = Mock_NowNs( );
+
+    if(( IS25LP_SIM_IDLE == sim->op ) || sim->suspended || ( now < sim->op_done_ns ))
+    {
+        return;
+    }
+
+    switch( sim->op )
+    {
+        case IS25LP_SIM_PROGRAM:
+            // Programming only clears bits
+            for( uint32_t i = 0; i < IS25LP_PAGE_SIZE; i++ )
+            {
+                sim->memory[ sim->op_address + i ] &= sim->op_data[ i ];
+            }
+            break;
+
+        case IS25LP_SIM_ERASE:
+        case IS25LP_SIM_CHIP_ERASE:
+            memset( &sim->memory[ sim->op_address ], 0xFF, sim->op_size );
+            break;
+
+        case IS25LP_SIM_WRSR:
+            sim->status = ( sim->status & ( SR_WIP | SR_WEL )) | ( sim->wrsr_value & ~( SR_WIP | SR_WEL ));
+            break;
+
+        default:
+            break;
+    }
+
+    sim->op = IS25LP_SIM_IDLE;
+    sim->status &= ~SR_WEL;
+}
+
+/**
+ * @brief  WIP at the current virtual time
+ */
+static bool Sim_Wip( sIS25LP_Sim_t *sim )
+{
+    Sim_Update( sim );
+
+    if( IS25LP_SIM_IDLE == sim->op )
+    {
+        return false;
+    }
+
+    return !sim->suspended || ( Mock_NowNs( ) < sim->suspend_ready_ns );
+}
+
+/**
+ * @brief  Start an internal operation (needs WEL)
+ */
+static void Sim_Start( sIS25LP_Sim_t *sim, eIS25LP_SimOp_t op, uint32_t address, uint32_t size, uint32_t time_us )
+{
+    if( 0 == ( sim->status & SR_WEL ))
+    {
+        sim->stats.ignored_no_wel++;
+        return;
+    }
+
+    sim->op = op;
+    sim->op_address = address;
+    sim->op_size = size;
+    sim->op_done_ns = Mock_NowNs( ) + ( time_us * US );
+}
+
+/**
+ * @brief  Byte from the array, flags reads of the unit a suspended operation changes
+ */
+static uint8_t Sim_ReadArray( sIS25LP_Sim_t *sim, uint32_t address )
+{
+    address %= IS25LP_CHIP_SIZE;
+
+    if( sim->suspended && ( address >= sim->op_address ) && ( address < ( sim->op_address + sim->op_size )))
+    {
+        sim->stats.suspended_reads++;
+    }
+
+    return sim->memory[ address ];
+}
+
+/**
+ * @brief  Opcodes the model implements
+ */
+static bool Sim_Known( uint8_t opcode )
+{
+    static const uint8_t known[] = {
+        OP_WRSR, OP_PP, OP_READ, OP_WRDI, OP_RDSR, OP_WREN, OP_FAST_READ, OP_SE, OP_RDFR, OP_RDUID, OP_BE32,
+        OP_CE_ALT, OP_SUSPEND, OP_RESUME, OP_RDMDID, OP_RDJDID, OP_RDID, OP_SUSPEND_ALT, OP_DP, OP_CE, OP_BE64, OP_RESUME_ALT
+    };
+
+    for( uint32_t i = 0; i < sizeof( known ); i++ )
+    {
+        if( known[ i ] == opcode )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  Commands that may start while WIP = 1
+ */
+static bool Sim_AllowedBusy( uint8_t opcode )
+{
+    return ( OP_RDSR == opcode ) || ( OP_RDFR == opcode ) || ( OP_SUSPEND == opcode ) || ( OP_SUSPEND_ALT == opcode );
+}
+
+/**
+ * @brief  Commands refused while a program/erase is suspended
+ */
+static bool Sim_RefusedSuspended( uint8_t opcode )
+{
+    return ( OP_WRSR == opcode ) || ( OP_PP == opcode ) || ( OP_SE == opcode ) || ( OP_BE32 == opcode )
+        || ( OP_BE64 == opcode ) || ( OP_CE == opcode ) || ( OP_CE_ALT == opcode );
+}
+
+static void Sim_Suspend( sIS25LP_Sim_t *sim )
+{
+    uint64_t now = Mock_NowNs( );
+
+    Sim_Update( sim );
+
+    // Chip erase and status writes cannot be suspended
+    if(( IS25LP_SIM_PROGRAM != sim->op ) && ( IS25LP_SIM_ERASE != sim->op ))
+    {
+        return;
+    }
+
+    if( sim->suspended )
+    {
+        return;
+    }
+
+    if(( 0 != sim->resume_ns ) && (( now - sim->resume_ns ) < ( sim->timing.trs_us * US )))
+    {
+        sim->stats.trs_violations++;
+        return;
+    }
+
+    uint64_t ready = now + ( sim->timing.tsus_us * US );
+
+    // Finishes on its own before the suspend takes effect
+    if( sim->op_done_ns <= ready )
+    {
+        return;
+    }
+
+    sim->suspended = true;
+    sim->suspend_ready_ns = ready;
+    sim->remaining_ns = sim->op_done_ns - ready;
+    sim->function |= ( IS25LP_SIM_PROGRAM == sim->op ) ? FR_PSUS : FR_ESUS;
+    sim->stats.suspends++;
+}
+
+static void Sim_Resume( sIS25LP_Sim_t *sim )
+{
+    uint64_t now = Mock_NowNs( );
+
+    if( !sim->suspended || ( now < sim->suspend_ready_ns ))
+    {
+        return;
+    }
+
+    sim->suspended = false;
+    sim->op_done_ns = now + sim->remaining_ns;
+    sim->resume_ns = now;
+    sim->function &= ~( FR_PSUS | FR_ESUS );
+}
+
+/**
+ * @brief  CS edge: a rising edge executes the latched command
+ */
+static void Sim_Select( void *context, bool selected )
+{
+    sIS25LP_Sim_t *sim = ( sIS25LP_Sim_t * )context;
+
+    if( selected )
+    {
+        sim->count = 0;
+        sim->address = 0;
+        return;
+    }
+
+    if( 0 == sim->count )
+    {
+        return;
+    }
+
+    sim->stats.commands++;
+
+    // Everything but RDID/RDPD is ignored in deep power-down, and during tRES1
+    if( sim->power_down || ( Mock_NowNs( ) < sim->ready_ns ))
+    {
+        if( sim->power_down && ( OP_RDID == sim->opcode ))
+        {
+            sim->power_down = false;
+            sim->ready_ns = Mock_NowNs( ) + ( sim->timing.tres1_us * US );
+        }
+        return;
+    }
+
+    if( Sim_Wip( sim ))
+    {
+        if( OP_SUSPEND == sim->opcode || OP_SUSPEND_ALT == sim->opcode )
+        {
+            Sim_Suspend( sim );
+        }
+        else if( !Sim_AllowedBusy( sim->opcode ))
+        {
+            sim->stats.ignored_busy++;
+        }
+        return;
+    }
+
+    if( sim->suspended && Sim_RefusedSuspended( sim->opcode ))
+    {
+        sim->stats.ignored_suspend++;
+        return;
+    }
+
+    switch( sim->opcode )
+    {
+        case OP_WREN:
+            if( 1 == sim->count )
+            {
+                sim->status |= SR_WEL;
+            }
+            break;
+
+        case OP_WRDI:
+            if( 1 == sim->count )
+            {
+                sim->status &= ~SR_WEL;
+            }
+            break;
+
+        case OP_WRSR:
+            if( 2 == sim->count )
+            {
+                Sim_Start( sim, IS25LP_SIM_WRSR, 0, 0, sim->timing.tw_us );
+            }
+            break;
+
+        case OP_PP:
+            if( sim->count > 4 )
+            {
+                memcpy( sim->op_data, sim->page, sizeof( sim->page ));
+                Sim_Start( sim, IS25LP_SIM_PROGRAM, sim->address & ~( IS25LP_PAGE_SIZE - 1 ), IS25LP_PAGE_SIZE, sim->timing.tpp_us );
+                sim->stats.page_programs++;
+            }
+            break;
+
+        case OP_SE:
+        case OP_BE32:
+        case OP_BE64:
+            // CS must rise right after the last address bit
+            if( 4 == sim->count )
+            {
+                uint32_t size = ( OP_SE == sim->opcode ) ? IS25LP_SECTOR_SIZE : ( OP_BE32 == sim->opcode ) ? IS25LP_BLOCK_32K_SIZE : IS25LP_BLOCK_64K_SIZE;
+                uint32_t time = ( OP_SE == sim->opcode ) ? sim->timing.tse_us : ( OP_BE32 == sim->opcode ) ? sim->timing.tbe32_us : sim->timing.tbe64_us;
+
+                Sim_Start( sim, IS25LP_SIM_ERASE, ( sim->address % IS25LP_CHIP_SIZE ) & ~( size - 1 ), size, time );
+                sim->stats.erases++;
+            }
+            break;
+
+        case OP_CE:
+        case OP_CE_ALT:
+            if( 1 == sim->count )
+            {
+                Sim_Start( sim, IS25LP_SIM_CHIP_ERASE, 0, IS25LP_CHIP_SIZE, sim->timing.tce_us );
+                sim->stats.erases++;
+            }
+            break;
+
+        case OP_RESUME:
+        case OP_RESUME_ALT:
+            Sim_Resume( sim );
+            break;
+
+        case OP_DP:
+            if( 1 == sim->count )
+            {
+                sim->power_down = true;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief  One byte while selected
+ */
+static uint8_t Sim_Exchange( void *context, uint8_t mosi, uint32_t spi_hz )
+{
+    sIS25LP_Sim_t *sim = ( sIS25LP_Sim_t * )context;
+    uint32_t n = sim->count++;
+    uint8_t miso = 0xFF;
+
+    if( 0 == n )
+    {
+        sim->opcode = mosi;
+
+        if( !Sim_Known( mosi ))
+        {
+            sim->stats.unknown++;
+        }
+
+        if( spi_hz > sim->timing.fast_max_hz )
+        {
+            sim->stats.overclocked++;
+        }
+        return miso;
+    }
+
+    // Deep power-down: only RDID answers (and releases on CS high)
+    if(( sim->power_down && ( OP_RDID != sim->opcode )) || ( Mock_NowNs( ) < sim->ready_ns ))
+    {
+        return miso;
+    }
+
+    // While busy only status and suspend get an answer
+    if( !Sim_AllowedBusy( sim->opcode ) && Sim_Wip( sim ))
+    {
+        return miso;
+    }
+
+    // 24-bit address phase
+    if(( n <= 3 ) && ( OP_RDSR != sim->opcode ) && ( OP_RDFR != sim->opcode ) && ( OP_RDJDID != sim->opcode ) && ( OP_WRSR != sim->opcode ))
+    {
+        sim->address = ( sim->address << 8 ) | mosi;
+        return miso;
+    }
+
+    switch( sim->opcode )
+    {
+        case OP_RDSR:
+            miso = sim->status | ( Sim_Wip( sim ) ? SR_WIP : 0 );
+            break;
+
+        case OP_RDFR:
+            miso = sim->function;
+            break;
+
+        case OP_WRSR:
+            if( 1 == n )
+            {
+                sim->wrsr_value = mosi;
+            }
+            break;
+
+        case OP_READ:
+            miso = Sim_ReadArray( sim, sim->address + ( n - 4 ));
+
+            // Output sampled too late above fC: data arrives one bit shifted
+            if( spi_hz > sim->timing.read_max_hz )
+            {
+                miso = ( uint8_t )(( miso >> 1 ) | 0x80 );
+                sim->stats.overclocked++;
+            }
+            break;
+
+        case OP_FAST_READ:
+            if( n >= 5 )
+            {
+                miso = Sim_ReadArray( sim, sim->address + ( n - 5 ));
+            }
+            break;
+
+        case OP_PP:
+            if( 4 == n )
+            {
+                memset( sim->page, 0xFF, sizeof( sim->page ));
+            }
+            // Past the page end the address wraps, the last 256 bytes win
+            sim->page[( sim->address + ( n - 4 )) & ( IS25LP_PAGE_SIZE - 1 )] = mosi;
+            break;
+
+        case OP_RDJDID:
+        {
+            static const uint8_t jedec[ 3 ] = { ID_MANUFACTURER, ID_MEMORY_TYPE, ID_CAPACITY };
+            miso = jedec[( n - 1 ) % 3 ];
+            break;
+        }
+
+        case OP_RDMDID:
+        {
+            // A0 = 1 swaps the order
+            bool swap = ( 0 != ( sim->address & 1 ));
+            bool first = ( 0 == (( n - 4 ) & 1 ));
+            miso = ( first != swap ) ? ID_MANUFACTURER : ID_DEVICE;
+            break;
+        }
+
+        case OP_RDID:
+            miso = ID_DEVICE;
+            break;
+
+        case OP_RDUID:
+            if( n >= 5 )
+            {
+                miso = sim->unique_id[( sim->address + ( n - 5 )) & 0x0F ];
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return miso;
+}
+
+/**
+ * @brief  Erased device with datasheet timing, attached to a bus
+ */
+void IS25LP_SimInit( sIS25LP_Sim_t *sim, SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin )
+{
+    memset( sim, 0, sizeof( *sim ));
+    memset( sim->memory, 0xFF, sizeof( sim->memory ));
+
+    for( uint32_t i = 0; i < sizeof( sim->unique_id ); i++ )
+    {
+        sim->unique_id[ i ] = ( uint8_t )( 0xA0 + i );
+    }
+
+    sim->timing.read_max_hz = 50000000;
+    sim->timing.fast_max_hz = 104000000;
+    sim->timing.tpp_us = 450;
+    sim->timing.tse_us = 70000;
+    sim->timing.tbe32_us = 130000;
+    sim->timing.tbe64_us = 200000;
+    sim->timing.tce_us = 1500000;
+    sim->timing.tw_us = 2000;
+    sim->timing.tsus_us = 100;
+    sim->timing.trs_us = 80;
+    sim->timing.tres1_us = 3;
+
+    sim->bus.spi = spi;
+    sim->bus.cs_port = cs_port;
+    sim->bus.cs_pin = cs_pin;
+    sim->bus.select = Sim_Select;
+    sim->bus.exchange = Sim_Exchange;
+    sim->bus.context = sim;
+    Mock_AttachDevice( &sim->bus );
+}
+
+/**
+ * @brief  Bring the model up to the current virtual time
+ */
+bool IS25LP_SimBusy( sIS25LP_Sim_t *sim )
+{
+    return Sim_Wip( sim );
+}
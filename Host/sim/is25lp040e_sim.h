@@ -0,0 +1,123 @@
+/**
+ * @file    is25lp040e_sim.h
+ * @brief   Header file for the IS25LP040E behavioural model (host builds).
+ *          Bit-accurate array, status/function registers and opcode set of
+ *          the driver, with a configurable timing model.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef SIM_IS25LP040E_SIM_H_
+#define SIM_IS25LP040E_SIM_H_
+
+/**
+ * @include necessary headers
+ */
+#include "stm32g0xx_hal.h"
+#include "is25lp040e.h"
+
+/**
+ * @struct sIS25LP_SimTiming_t
+ * @brief Device timing (datasheet typicals by default, see IS25LP_SimInit)
+ */
+typedef struct
+{
+    uint32_t read_max_hz;       // fC, 0x03 above this returns corrupted data
+    uint32_t fast_max_hz;       // fCT, every other opcode
+    uint32_t tpp_us;            // Page program
+    uint32_t tse_us;            // 4KB sector erase
+    uint32_t tbe32_us;          // 32KB block erase
+    uint32_t tbe64_us;          // 64KB block erase
+    uint32_t tce_us;            // Chip erase
+    uint32_t tw_us;             // Write status register
+    uint32_t tsus_us;           // Suspend to read ready
+    uint32_t trs_us;            // Resume to next suspend (minimum)
+    uint32_t tres1_us;          // Release from deep power-down
+} sIS25LP_SimTiming_t;
+
+/**
+ * @struct sIS25LP_SimStats_t
+ * @brief Model counters; the violation counters flag driver bugs
+ */
+typedef struct
+{
+    uint32_t commands;          // Transactions with at least an opcode
+    uint32_t page_programs;     // Programs started
+    uint32_t erases;            // Erases started (any size)
+    uint32_t suspends;          // Successful suspends
+    uint32_t ignored_busy;      // Commands sent while WIP = 1 (ignored)
+    uint32_t ignored_no_wel;    // Program/erase/WRSR without WEL (ignored)
+    uint32_t ignored_suspend;   // Commands not allowed while suspended (ignored)
+    uint32_t trs_violations;    // Suspend sooner than tRS after resume (ignored)
+    uint32_t suspended_reads;   // Array bytes read from the suspended page/unit
+    uint32_t overclocked;       // Bytes clocked above fC/fCT
+    uint32_t unknown;           // Unsupported opcodes
+} sIS25LP_SimStats_t;
+
+/**
+ * @enum eIS25LP_SimOp_t
+ * @brief Internal operation of the model
+ */
+typedef enum
+{
+    IS25LP_SIM_IDLE = 0,
+    IS25LP_SIM_PROGRAM,
+    IS25LP_SIM_ERASE,
+    IS25LP_SIM_CHIP_ERASE,
+    IS25LP_SIM_WRSR
+} eIS25LP_SimOp_t;
+
+/**
+ * @struct sIS25LP_Sim_t
+ * @brief One simulated IS25LP040E
+ */
+typedef struct
+{
+    sMock_SpiDevice_t bus;                  // Bus attachment
+    sIS25LP_SimTiming_t timing;             // Timing model
+    sIS25LP_SimStats_t stats;               // Counters
+    uint8_t memory[ IS25LP_CHIP_SIZE ];     // Array contents
+    uint8_t unique_id[ 16 ];                // RDUID data
+    uint8_t status;                         // Status register without WIP
+    uint8_t function;                       // Function register (PSUS/ESUS)
+    bool power_down;                        // Deep power-down
+    uint64_t ready_ns;                      // Commands ignored before this (tRES1)
+
+    // Current transaction
+    uint8_t opcode;
+    uint32_t count;                         // Bytes clocked since CS low
+    uint32_t address;
+    uint8_t page[ IS25LP_PAGE_SIZE ];       // Page program latch
+    uint8_t wrsr_value;
+
+    // Internal operation
+    eIS25LP_SimOp_t op;
+    uint32_t op_address;                    // Start of the page/unit being changed
+    uint32_t op_size;
+    uint8_t op_data[ IS25LP_PAGE_SIZE ];    // Data being programmed
+    uint64_t op_done_ns;                    // Completion time while running
+    bool suspended;
+    uint64_t suspend_ready_ns;              // WIP drops at this time after a suspend
+    uint64_t remaining_ns;                  // Busy time left while suspended
+    uint64_t resume_ns;                     // Last resume (tRS)
+} sIS25LP_Sim_t;
+
+/**
+ * @brief  Erased device with datasheet timing, attached to a bus
+ * @param  sim: Model state
+ * @param  spi: SPI instance the device is wired to
+ * @param  cs_port: Chip select port, NULL when wired to the hardware NSS
+ * @param  cs_pin: Chip select pin
+ */
+void IS25LP_SimInit(sIS25LP_Sim_t *sim, SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin);
+
+/**
+ * @brief  Bring the model up to the current virtual time
+ * @param  sim: Model state
+ * @retval true while WIP is set
+ */
+bool IS25LP_SimBusy(sIS25LP_Sim_t *sim);
+
+#endif /* SIM_IS25LP040E_SIM_H_ */
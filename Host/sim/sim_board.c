@@ -0,0 +1,110 @@
+/**
+ * @file    sim_board.c
+ * @brief   Host stand-in for the board setup in main.c.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "sim_board.h"
+#include "main.h"
+
+#include <string.h>
+
+SPI_HandleTypeDef hspi1;
+static DMA_HandleTypeDef s_hdma_rx = { DMA1_Channel1 };
+static DMA_HandleTypeDef s_hdma_tx = { DMA1_Channel2 };
+
+// Chip selects of the multi-chip board: the flash on PA4, further chips on PB0..PB2
+static const sIS25LP_GPIO_t s_bus_cs[ SIM_BOARD_MAX_CHIPS ] = {
+    { SPI1_NSS_GPIO_Port, SPI1_NSS_Pin },
+    { GPIOB, GPIO_PIN_0 },
+    { GPIOB, GPIO_PIN_1 },
+    { GPIOB, GPIO_PIN_2 }
+};
+
+/**
+ * @brief  Common SPI1 setup
+ */
+static void SimBoard_SetupSpi( eIS25LP_CSMode_t cs_mode, uint32_t prescaler )
+{
+    Mock_Reset( );
+
+    memset( &hspi1, 0, sizeof( hspi1 ));
+    hspi1.Instance = SPI1;
+    hspi1.Init.BaudRatePrescaler = prescaler;
+    hspi1.hdmarx = &s_hdma_rx;
+    hspi1.hdmatx = &s_hdma_tx;
+    SPI1->CR1 = prescaler | (( IS25LP_CS_GPIO == cs_mode ) ? SPI_CR1_SPE : 0 );
+}
+
+/**
+ * @brief  Reset virtual time, attach sim to SPI1 and initialize handle
+ */
+eIS25LP_Status_t SimBoard_Init( sIS25LP_Handle_t *handle, sIS25LP_Sim_t *sim, eIS25LP_CSMode_t cs_mode, uint32_t prescaler )
+{
+    SimBoard_SetupSpi( cs_mode, prescaler );
+
+    IS25LP_SimInit( sim, SPI1, ( IS25LP_CS_GPIO == cs_mode ) ? SPI1_NSS_GPIO_Port : NULL, SPI1_NSS_Pin );
+
+    memset( handle, 0, sizeof( *handle ));
+    handle->spi_handle = &hspi1;
+    handle->cs_gpio.port = SPI1_NSS_GPIO_Port;
+    handle->cs_gpio.pin = SPI1_NSS_Pin;
+    handle->cs_mode = cs_mode;
+    handle->wp_gpio.port = FLASH_WP_GPIO_Port;
+    handle->wp_gpio.pin = FLASH_WP_Pin;
+
+    return IS25LP_Init( handle );
+}
+
+/**
+ * @brief  Reset virtual time and put count chips on SPI1 behind one bus
+ */
+eIS25LP_Status_t SimBoard_InitBus( sIS25LP_Bus_t *bus, sIS25LP_Handle_t *handles, sIS25LP_Sim_t *sims, uint32_t count, uint32_t prescaler )
+{
+    if(( count > SIM_BOARD_MAX_CHIPS ) || ( IS25LP_OK != IS25LP_BusInit( bus, &hspi1 )))
+    {
+        return IS25LP_ERROR;
+    }
+
+    SimBoard_SetupSpi( IS25LP_CS_GPIO, prescaler );
+
+    for( uint32_t n = 0; n < count; n++ )
+    {
+        IS25LP_SimInit( &sims[ n ], SPI1, s_bus_cs[ n ].port, s_bus_cs[ n ].pin );
+    }
+
+    for( uint32_t n = 0; n < count; n++ )
+    {
+        memset( &handles[ n ], 0, sizeof( handles[ n ] ));
+        handles[ n ].cs_gpio = s_bus_cs[ n ];
+        handles[ n ].cs_mode = IS25LP_CS_GPIO;
+        handles[ n ].wp_gpio.port = FLASH_WP_GPIO_Port;
+        handles[ n ].wp_gpio.pin = FLASH_WP_Pin;
+
+        if( IS25LP_OK != IS25LP_BusAttach( bus, &handles[ n ] ))
+        {
+            return IS25LP_ERROR;
+        }
+    }
+
+    return IS25LP_OK;
+}
+
+/**
+ * @brief  Same routing as main.c
+ */
+void HAL_SPI_TxRxCpltCallback( SPI_HandleTypeDef *hspi )
+{
+    IS25LP_SPI_TxRxCpltCallback( hspi );
+}
+
+void HAL_SPI_ErrorCallback( SPI_HandleTypeDef *hspi )
+{
+    IS25LP_SPI_ErrorCallback( hspi );
+}
@@ -0,0 +1,51 @@
+/**
+ * @file    sim_board.h
+ * @brief   Host stand-in for the board setup in main.c.
+ *          Wires SPI1, its DMA channels and one simulated IS25LP040E.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+#ifndef SIM_SIM_BOARD_H_
+#define SIM_SIM_BOARD_H_
+
+/**
+ * @include necessary headers
+ */
+#include "is25lp040e.h"
+#include "is25lp040e_bus.h"
+#include "is25lp040e_sim.h"
+
+#define SIM_BOARD_MAX_CHIPS     4       // Chip selects available for SimBoard_InitBus
+
+extern SPI_HandleTypeDef hspi1;
+
+/**
+ * @brief  Reset virtual time, attach sim to SPI1 and initialize handle
+ * @param  handle: Driver handle to set up
+ * @param  sim: Model to attach (erased, datasheet timing)
+ * @param  cs_mode: IS25LP_CS_GPIO (PA4 via BSRR/BRR) or IS25LP_CS_HW_NSS
+ * @param  prescaler: SPI_BAUDRATEPRESCALER_x the CubeMX config would set
+ * @retval Result of IS25LP_Init()
+ * 
+ * @details Adjust sim->timing or Mock_GetConfig() before the first driver
+ *          call to model a different part or platform.
+ */
+eIS25LP_Status_t SimBoard_Init(sIS25LP_Handle_t *handle, sIS25LP_Sim_t *sim, eIS25LP_CSMode_t cs_mode, uint32_t prescaler);
+
+/**
+ * @brief  Reset virtual time and put several chips on SPI1 behind one bus
+ * @param  bus: Bus to set up
+ * @param  handles: count driver handles, attached in order
+ * @param  sims: count models (erased, datasheet timing)
+ * @param  count: Number of chips, up to SIM_BOARD_MAX_CHIPS
+ * @param  prescaler: SPI_BAUDRATEPRESCALER_x the CubeMX config would set
+ * @retval IS25LP_OK if every IS25LP_BusAttach() succeeded
+ *
+ * @details Chip 0 uses the PA4 chip select, chips 1-3 use PB0-PB2.
+ */
+eIS25LP_Status_t SimBoard_InitBus(sIS25LP_Bus_t *bus, sIS25LP_Handle_t *handles, sIS25LP_Sim_t *sims, uint32_t count, uint32_t prescaler);
+
+#endif /* SIM_SIM_BOARD_H_ */
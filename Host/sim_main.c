@@ -0,0 +1,374 @@
+/**
+ * @file    sim_main.c
+ * @brief   Host smoke run of the IS25LP040E driver against the simulator.
+ *          Exercises the main driver paths and reports model counters.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ * 
+ * @copyright Copyright (c) 2025 MootSeeker
+ */
+
+/**
+ * @include necessary headers
+ */
+#include "sim_board.h"
+#include "is25lp040e_sched.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static sIS25LP_Handle_t flash_handle;
+static sIS25LP_Sim_t flash_sim;
+static uint8_t tx_buffer[ 3 * IS25LP_PAGE_SIZE ];
+static uint8_t rx_buffer[ 3 * IS25LP_PAGE_SIZE ];
+static uint8_t sector_buffer[ IS25LP_SECTOR_SIZE ];
+static uint32_t failures;
+
+static sIS25LP_Scheduler_t sched;
+static uint8_t sched_data[ IS25LP_PAGE_SIZE ];
+static uint8_t sched_check[ IS25LP_PAGE_SIZE ];
+
+static sIS25LP_Bus_t bus;
+static sIS25LP_Handle_t bus_chips[ SIM_BOARD_MAX_CHIPS ];
+static sIS25LP_Sim_t bus_sims[ SIM_BOARD_MAX_CHIPS ];
+static uint8_t bus_data[ 64 * 1024 ];
+static uint8_t bus_check[ 64 * 1024 ];
+
+static void Check( bool ok, const char *what )
+{
+    printf( "%-48s %s\n", what, ok ? "ok" : "FAIL" );
+
+    if( !ok )
+    {
+        failures++;
+    }
+}
+
+/**
+ * @brief  One pass over the driver with the given chip select method
+ */
+static void Run( eIS25LP_CSMode_t cs_mode )
+{
+    printf( "\n== %s chip select\n", ( IS25LP_CS_GPIO == cs_mode ) ? "GPIO" : "hardware NSS" );
+
+    Check( IS25LP_OK == SimBoard_Init( &flash_handle, &flash_sim, cs_mode, SPI_BAUDRATEPRESCALER_2 ), "IS25LP_Init" );
+    // Blank chip: without opt-in the calibration sector is left alone
+    uint32_t cal_programs = flash_sim.stats.page_programs;
+    uint32_t default_prescaler = flash_handle.clock.fast_prescaler;
+
+    Check(( IS25LP_ERROR == IS25LP_CalibrateClock( &flash_handle, IS25LP_CHIP_SIZE - IS25LP_SECTOR_SIZE, false ))
+        && ( cal_programs == flash_sim.stats.page_programs ) && ( default_prescaler == flash_handle.clock.fast_prescaler ),
+        "Calibration without pattern keeps defaults" );
+    Check( IS25LP_OK == IS25LP_CalibrateClock( &flash_handle, IS25LP_CHIP_SIZE - IS25LP_SECTOR_SIZE, true ), "IS25LP_CalibrateClock" );
+    Check( IS25LP_OK == IS25LP_CalibrateClock( &flash_handle, IS25LP_CHIP_SIZE - IS25LP_SECTOR_SIZE, false ), "IS25LP_CalibrateClock with pattern present" );
+    Check( IS25LP_OK == IS25LP_SetSectorBuffer( &flash_handle, sector_buffer ), "IS25LP_SetSectorBuffer" );
+
+    for( uint32_t i = 0; i < sizeof( tx_buffer ); i++ )
+    {
+        tx_buffer[ i ] = ( uint8_t )( i * 7 + 3 );
+    }
+
+    // Unaligned multi-page write across two page boundaries
+    Check( IS25LP_OK == IS25LP_EraseSector( &flash_handle, 0x1000 ), "IS25LP_EraseSector" );
+    Check( IS25LP_OK == IS25LP_Write( &flash_handle, 0x1080, tx_buffer, sizeof( tx_buffer )), "IS25LP_Write (unaligned, 3 pages)" );
+    Check( IS25LP_OK == IS25LP_Flush( &flash_handle ), "IS25LP_Flush" );
+
+    memset( rx_buffer, 0, sizeof( rx_buffer ));
+    Check(( IS25LP_OK == IS25LP_Read( &flash_handle, 0x1080, rx_buffer, sizeof( rx_buffer )))
+        && ( 0 == memcmp( rx_buffer, tx_buffer, sizeof( tx_buffer ))), "IS25LP_Read matches" );
+
+    memset( rx_buffer, 0, sizeof( rx_buffer ));
+    Check(( IS25LP_OK == IS25LP_FastRead( &flash_handle, 0x1080, rx_buffer, 16 ))
+        && ( 0 == memcmp( rx_buffer, tx_buffer, 16 )), "IS25LP_FastRead (LL path) matches" );
+
+#if IS25LP_WCACHE_LINES > 0
+    // A timed-out page is programmed by the tick alone, no further write or flush needed
+    uint32_t programs = flash_sim.stats.page_programs;
+
+    Check( IS25LP_OK == IS25LP_Write( &flash_handle, 0x1400, tx_buffer, 4 ), "IS25LP_Write (cached)" );
+    IS25LP_AsyncTick( &flash_handle );
+    Check( programs == flash_sim.stats.page_programs, "Young page stays cached" );
+    Mock_AdvanceNs(( IS25LP_WCACHE_TIMEOUT_MS + 1 ) * 1000000ULL );
+    IS25LP_AsyncTick( &flash_handle );
+    Check(( programs + 1 ) == flash_sim.stats.page_programs, "AsyncTick programs the timed-out page" );
+    bool released = true;
+
+    for( uint32_t n = 0; n < IS25LP_WCACHE_LINES; n++ )
+    {
+        released = released && ( IS25LP_CACHE_INVALID == flash_handle.wcache[ n ].address );
+    }
+    Check( released && ( IS25LP_OK == IS25LP_Read( &flash_handle, 0x1400, rx_buffer, 4 )) && ( 0 == memcmp( rx_buffer, tx_buffer, 4 )),
+        "Timed-out page is on the flash" );
+#endif
+
+    // Programming only clears bits: 0x0F over the written data
+    uint8_t mask = 0x0F;
+    Check( IS25LP_OK == IS25LP_WritePage( &flash_handle, 0x1080, &mask, 1 ), "IS25LP_WritePage over data" );
+    Check(( IS25LP_OK == IS25LP_Read( &flash_handle, 0x1080, rx_buffer, 1 )) && ( rx_buffer[ 0 ] == ( tx_buffer[ 0 ] & 0x0F )), "AND-only programming" );
+
+    // Update rewrites the sector behind the scenes
+    Check( IS25LP_OK == IS25LP_Update( &flash_handle, 0x1080, tx_buffer, 8 ), "IS25LP_Update" );
+    Check(( IS25LP_OK == IS25LP_Read( &flash_handle, 0x1080, rx_buffer, 8 )) && ( 0 == memcmp( rx_buffer, tx_buffer, 8 )), "IS25LP_Update result" );
+
+    // Read served while a 64KB erase runs in the background
+    flash_handle.read_suspend = true;
+    Check( IS25LP_OK == IS25LP_EraseAsync( &flash_handle, IS25LP_ERASE_BLOCK_64K, 0x20000, NULL, NULL ), "IS25LP_EraseAsync 64KB" );
+    uint64_t start = Mock_NowNs( );
+    Check(( IS25LP_OK == IS25LP_Read( &flash_handle, 0x1080, rx_buffer, 8 )) && ( 0 == memcmp( rx_buffer, tx_buffer, 8 )), "Read during erase (suspend)" );
+    printf( "  read latency during erase: %lu us\n", ( unsigned long )(( Mock_NowNs( ) - start ) / 1000 ));
+
+    while( IS25LP_IsAsyncBusy( &flash_handle ))
+    {
+        IS25LP_AsyncTick( &flash_handle );
+    }
+    Check( IS25LP_IsBlank( &flash_handle, 0x20000, IS25LP_BLOCK_64K_SIZE ), "Erased block is blank" );
+
+    sMock_BusStats_t *bus = Mock_GetBusStats( );
+    sIS25LP_SimStats_t *stats = &flash_sim.stats;
+
+    printf( "  virtual time %lu us, %llu bytes on the bus, %lu DMA transfers\n",
+            ( unsigned long )( Mock_NowNs( ) / 1000 ), ( unsigned long long )bus->bytes, ( unsigned long )bus->dma_transfers );
+    printf( "  commands %lu, programs %lu, erases %lu, suspends %lu\n",
+            ( unsigned long )stats->commands, ( unsigned long )stats->page_programs, ( unsigned long )stats->erases, ( unsigned long )stats->suspends );
+
+#if IS25LP_USE_STATS
+    // Driver instrumentation sees every byte the bus moved
+    sIS25LP_Stats_t counters;
+    uint64_t counted = 0;
+    uint32_t transfer_us = 0;
+    uint32_t wait_us = 0;
+
+    Check( IS25LP_OK == IS25LP_GetStats( &flash_handle, &counters ), "IS25LP_GetStats" );
+
+    for( uint32_t n = 0; n < IS25LP_STAT_OPCODE_COUNT; n++ )
+    {
+        counted += counters.opcode[ n ].bytes;
+        transfer_us += counters.opcode[ n ].time_us;
+    }
+    for( uint32_t n = 0; n < IS25LP_OP_COUNT; n++ )
+    {
+        wait_us += counters.wait[ n ].time_us;
+    }
+
+    printf( "  stats: %lu us in transfers, %lu us waiting, %lu page programs\n",
+            ( unsigned long )transfer_us, ( unsigned long )wait_us, ( unsigned long )counters.opcode[ IS25LP_STAT_PAGE_PROGRAM ].count );
+    Check(( counted == bus->bytes ) && ( counters.opcode[ IS25LP_STAT_PAGE_PROGRAM ].count == stats->page_programs ), "Stats match the bus" );
+#endif
+
+    Check(( 0 == stats->ignored_busy ) && ( 0 == stats->ignored_no_wel ) && ( 0 == stats->ignored_suspend )
+        && ( 0 == stats->trs_violations ) && ( 0 == stats->suspended_reads ) && ( 0 == stats->overclocked )
+        && ( 0 == stats->unknown ) && ( 0 == bus->conflicts ), "No protocol violations" );
+}
+
+/**
+ * @brief  Tick the scheduler until every request completed
+ */
+static void SchedDrain( void )
+{
+    while( IS25LP_SchedPending( &sched ) > 0 )
+    {
+        IS25LP_SchedTick( &sched );
+    }
+}
+
+/**
+ * @brief  Dependent requests keep submission order despite class priorities
+ */
+static void RunSched( void )
+{
+    printf( "\n== Request scheduler\n" );
+
+    Check( IS25LP_OK == SimBoard_Init( &flash_handle, &flash_sim, IS25LP_CS_GPIO, SPI_BAUDRATEPRESCALER_2 ), "IS25LP_Init" );
+    Check( IS25LP_OK == IS25LP_SchedInit( &sched, &flash_handle ), "IS25LP_SchedInit" );
+    flash_handle.read_suspend = true;
+    memset( sched_data, 0xA5, sizeof( sched_data ));
+
+    // Erase then program the same sector: the program (priority 1) must not overtake the erase (2)
+    Check( IS25LP_OK == IS25LP_WritePage( &flash_handle, 0x2000, tx_buffer, IS25LP_PAGE_SIZE ), "Old data in the sector" );
+    Check(( IS25LP_OK == IS25LP_SchedErase( &sched, IS25LP_ERASE_SECTOR, 0x2000, NULL, NULL ))
+        && ( IS25LP_OK == IS25LP_SchedWrite( &sched, 0x2000, sched_data, sizeof( sched_data ), NULL, NULL ))
+        && ( IS25LP_OK == IS25LP_SchedRead( &sched, 0x2000, sched_check, sizeof( sched_check ), NULL, NULL )), "Queue erase, program, read" );
+    SchedDrain( );
+    Check( 0 == memcmp( sched_check, sched_data, sizeof( sched_data )), "Read after program sees the new data" );
+    Check(( IS25LP_OK == IS25LP_Read( &flash_handle, 0x2000, sched_check, sizeof( sched_check )))
+        && ( 0 == memcmp( sched_check, sched_data, sizeof( sched_data ))), "Erase ran before the program" );
+
+    // Erase then read: the read must not preempt the erase of its own range
+    Check(( IS25LP_OK == IS25LP_SchedErase( &sched, IS25LP_ERASE_SECTOR, 0x2000, NULL, NULL ))
+        && ( IS25LP_OK == IS25LP_SchedRead( &sched, 0x2080, sched_check, sizeof( sched_check ), NULL, NULL )), "Queue erase, read" );
+    SchedDrain( );
+    Check( IS25LP_IsBlank( &flash_handle, 0x2000, IS25LP_SECTOR_SIZE ) && ( 0xFF == sched_check[ 0 ] )
+        && ( 0 == memcmp( sched_check, sched_check + 1, sizeof( sched_check ) - 1 )), "Read after erase sees blank data" );
+
+    // Program then read: the read must not preempt the program of its own range
+    memset( sched_check, 0, sizeof( sched_check ));
+    Check(( IS25LP_OK == IS25LP_SchedWrite( &sched, 0x2000, sched_data, sizeof( sched_data ), NULL, NULL ))
+        && ( IS25LP_OK == IS25LP_SchedRead( &sched, 0x2000, sched_check, sizeof( sched_check ), NULL, NULL )), "Queue program, read" );
+    SchedDrain( );
+    Check( 0 == memcmp( sched_check, sched_data, sizeof( sched_data )), "Read after program sees the new data" );
+
+    // An independent read still preempts a running erase
+    uint32_t preempted = sched.stats.preempted;
+
+    Check( IS25LP_OK == IS25LP_SchedErase( &sched, IS25LP_ERASE_SECTOR, 0x3000, NULL, NULL ), "Queue erase" );
+    IS25LP_SchedTick( &sched );
+    Check( IS25LP_OK == IS25LP_SchedRead( &sched, 0x2000, sched_check, 16, NULL, NULL ), "Queue read elsewhere" );
+    IS25LP_SchedTick( &sched );
+    Check(( preempted < sched.stats.preempted ) && ( 1 == IS25LP_SchedPending( &sched )), "Independent read preempted the erase" );
+    SchedDrain( );
+
+    sIS25LP_SimStats_t *stats = &flash_sim.stats;
+
+    Check(( 0 == stats->ignored_busy ) && ( 0 == stats->ignored_no_wel ) && ( 0 == stats->ignored_suspend )
+        && ( 0 == stats->trs_violations ) && ( 0 == stats->suspended_reads ) && ( 0 == stats->unknown ), "No protocol violations" );
+
+    flash_handle.read_suspend = false;
+}
+
+static void BusDone( sIS25LP_Bus_t *done_bus, eIS25LP_Status_t status, void *context )
+{
+    ( void )done_bus;
+    *( eIS25LP_Status_t* )context = status;
+}
+
+/**
+ * @brief  Tick the bus until its operation completes, returns the virtual time in us
+ */
+static uint32_t BusWait( void )
+{
+    uint64_t start = Mock_NowNs( );
+
+    while( IS25LP_BusIsBusy( &bus ))
+    {
+        IS25LP_BusTick( &bus );
+    }
+
+    return ( uint32_t )(( Mock_NowNs( ) - start ) / 1000 );
+}
+
+/**
+ * @brief  Striped erase/program/read on count chips sharing SPI1
+ * @retval Virtual time of the 64KB program in us
+ */
+static uint32_t RunBus( uint32_t count )
+{
+    eIS25LP_Status_t result = IS25LP_ERROR;
+    bool calibrated = true;
+
+    printf( "\n== %lu-chip bus\n", ( unsigned long )count );
+
+    Check( IS25LP_OK == SimBoard_InitBus( &bus, bus_chips, bus_sims, count, SPI_BAUDRATEPRESCALER_2 ), "SimBoard_InitBus" );
+    for( uint32_t n = 0; n < count; n++ )
+    {
+        calibrated = calibrated && ( IS25LP_OK == IS25LP_CalibrateClock( &bus_chips[ n ], IS25LP_CHIP_SIZE - IS25LP_SECTOR_SIZE, true ));
+    }
+    Check( calibrated, "IS25LP_CalibrateClock per chip" );
+    Check( IS25LP_BusSize( &bus ) == ( count * IS25LP_CHIP_SIZE ), "IS25LP_BusSize" );
+
+    for( uint32_t i = 0; i < sizeof( bus_data ); i++ )
+    {
+        bus_data[ i ] = ( uint8_t )(( i >> 8 ) ^ ( i * 13 ));
+    }
+
+    Check(( IS25LP_OK == IS25LP_BusErase( &bus, 0, 4 * IS25LP_BLOCK_64K_SIZE, BusDone, &result )), "IS25LP_BusErase 256KB" );
+    printf( "  erase 256KB: %lu us\n", ( unsigned long )BusWait( ));
+    Check( IS25LP_OK == result, "Erase completed" );
+
+    // Unaligned start and end: partial first and last stripes
+    uint32_t length = sizeof( bus_data ) - 0x100;
+    result = IS25LP_ERROR;
+    Check(( IS25LP_OK == IS25LP_BusWrite( &bus, 0x80, bus_data, length, BusDone, &result )), "IS25LP_BusWrite 64KB" );
+    uint32_t write_us = BusWait( );
+    printf( "  program 64KB: %lu us\n", ( unsigned long )write_us );
+    Check( IS25LP_OK == result, "Program completed" );
+
+    memset( bus_check, 0, sizeof( bus_check ));
+    Check(( IS25LP_OK == IS25LP_BusRead( &bus, 0x80, bus_check, length )) && ( 0 == memcmp( bus_check, bus_data, length )), "IS25LP_BusRead matches" );
+
+    if( count > 1 )
+    {
+        // Chip 1 is read while chip 0 erases one of its stripes
+        uint32_t stripe = count * IS25LP_BUS_STRIPE_SIZE * 8;
+
+        Check(( IS25LP_OK == IS25LP_BusErase( &bus, stripe, IS25LP_BUS_STRIPE_SIZE, NULL, NULL )), "IS25LP_BusErase on chip 0" );
+        uint64_t start = Mock_NowNs( );
+        Check(( IS25LP_OK == IS25LP_BusRead( &bus, IS25LP_BUS_STRIPE_SIZE, bus_check, 256 ))
+            && ( 0 == memcmp( bus_check, bus_data + IS25LP_BUS_STRIPE_SIZE - 0x80, 256 )) && IS25LP_BusIsBusy( &bus ), "Read chip 1 during erase of chip 0" );
+        printf( "  read latency: %lu us\n", ( unsigned long )(( Mock_NowNs( ) - start ) / 1000 ));
+        BusWait( );
+
+#if IS25LP_USE_DMA
+        // A command to chip 1 waits for the DMA read of chip 0 to release the bus
+        uint32_t rest = IS25LP_BUS_STRIPE_SIZE - 0x80;
+
+        Check( IS25LP_OK == IS25LP_ReadAsync( &bus_chips[ 0 ], 0x80, bus_check, rest, NULL, NULL ), "IS25LP_ReadAsync chip 0" );
+        Check(( IS25LP_OK == IS25LP_FastRead( &bus_chips[ 1 ], 0, bus_check + 4096, 16 ))
+            && ( 0 == memcmp( bus_check + 4096, bus_data + IS25LP_BUS_STRIPE_SIZE - 0x80, 16 )), "FastRead chip 1 behind it" );
+        while( IS25LP_IsAsyncBusy( &bus_chips[ 0 ] ))
+        {
+            IS25LP_AsyncTick( &bus_chips[ 0 ] );
+        }
+        Check( 0 == memcmp( bus_check, bus_data, rest ), "ReadAsync chip 0 data" );
+#endif
+    }
+
+    bool clean = ( 0 == Mock_GetBusStats( )->conflicts );
+
+    for( uint32_t n = 0; n < count; n++ )
+    {
+        sIS25LP_SimStats_t *stats = &bus_sims[ n ].stats;
+
+        clean = clean && ( 0 == stats->ignored_busy ) && ( 0 == stats->ignored_no_wel ) && ( 0 == stats->ignored_suspend )
+            && ( 0 == stats->trs_violations ) && ( 0 == stats->suspended_reads ) && ( 0 == stats->overclocked ) && ( 0 == stats->unknown );
+    }
+    Check( clean, "No protocol violations or bus conflicts" );
+
+    return write_us;
+}
+
+/**
+ * @details Usage: sim_main [trace dump file] (with IS25LP_TRACE_ENTRIES > 0)
+ */
+int main( int argc, char **argv )
+{
+    Run( IS25LP_CS_GPIO );
+    Run( IS25LP_CS_HW_NSS );
+    RunSched( );
+
+    // Time base inside an interrupt above SysTick priority, across a millisecond wrap
+    printf( "\n== Time base\n" );
+    Mock_AdvanceNs( 1000000ULL - ( Mock_NowNs( ) % 1000000ULL ) - 20000 );
+    Mock_GetConfig( )->tick_masked = true;
+    uint32_t before_us = IS25LP_GetMicros( );
+    Mock_AdvanceNs( 50000 );
+    uint32_t elapsed_us = IS25LP_GetMicros( ) - before_us;
+    Mock_GetConfig( )->tick_masked = false;
+    Check(( elapsed_us >= 45 ) && ( elapsed_us <= 60 ), "IS25LP_GetMicros monotonic with SysTick held off" );
+
+    // Four chips program in parallel, the bus is far from saturated
+    uint32_t single_us = RunBus( 1 );
+    uint32_t quad_us = RunBus( SIM_BOARD_MAX_CHIPS );
+
+    Check(( quad_us * 3 ) < single_us, "4 chips program at least 3x faster than 1" );
+
+#if IS25LP_TRACE_ENTRIES > 0
+    // Same raw memory a debugger dump of flash_handle.trace gives
+    if( argc > 1 )
+    {
+        FILE *file = fopen( argv[ 1 ], "wb" );
+
+        Check(( NULL != file ) && ( 1 == fwrite( &flash_handle.trace, sizeof( flash_handle.trace ), 1, file )), "Trace dump written" );
+        if( NULL != file )
+        {
+            fclose( file );
+        }
+    }
+#else
+    ( void )argc;
+    ( void )argv;
+#endif
+
+    printf( "\n%s (%lu failures)\n", ( 0 == failures ) ? "PASS" : "FAIL", ( unsigned long )failures );
+
+    return ( 0 == failures ) ? 0 : 1;
+}
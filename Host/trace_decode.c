@@ -0,0 +1,263 @@
+/**
+ * @file    trace_decode.c
+ * @brief   Decoder for IS25LP040E transaction trace dumps (sIS25LP_Trace_t).
+ *          Prints the transactions as a timeline followed by per-opcode
+ *          latency statistics.
+ * @author  MootSeeker
+ * @date    2025-11-17
+ *
+ * @copyright Copyright (c) 2025 MootSeeker
+ *
+ * @details Dump the ring of a target handle as raw memory, e.g. in GDB:
+ *          dump binary value trace.bin flash_handle.trace
+ *          The layout is little-endian: a 16-byte header (magic "ISTR",
+ *          record size, entries, head, open flag) followed by the records.
+ */
+
+/**
+ * @include necessary headers
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_MAGIC         0x52545349UL    // "ISTR"
+#define TRACE_HEADER_SIZE   16
+#define TRACE_RECORD_SIZE   16              // Smallest record this decoder understands
+#define TRACE_NO_ADDRESS    0xFFFFFFFFUL
+
+/**
+ * @struct sRecord_t
+ * @brief Decoded trace record
+ */
+typedef struct
+{
+    uint32_t start_us;
+    uint32_t end_us;
+    uint32_t address;
+    uint16_t length;
+    uint8_t opcode;
+    uint8_t status;
+} sRecord_t;
+
+static const struct
+{
+    uint8_t opcode;
+    const char *name;
+} s_opcodes[] = {
+    { 0x01, "WRSR" },   { 0x02, "PP" },     { 0x03, "READ" },   { 0x04, "WRDI" },
+    { 0x05, "RDSR" },   { 0x06, "WREN" },   { 0x0B, "FREAD" },  { 0x20, "SE" },
+    { 0x30, "RESUME" }, { 0x48, "RDFR" },   { 0x4B, "RDUID" },  { 0x52, "BE32K" },
+    { 0x75, "SUSP" },   { 0x7A, "RESUME" }, { 0x90, "RDMDID" }, { 0x9F, "RDJDID" },
+    { 0xAB, "RDPD" },   { 0xB0, "SUSP" },   { 0xB9, "DP" },     { 0xC7, "CE" },
+    { 0xD8, "BE64K" }
+};
+
+static uint32_t Load32( const uint8_t *p )
+{
+    return ( uint32_t )p[ 0 ] | (( uint32_t )p[ 1 ] << 8 ) | (( uint32_t )p[ 2 ] << 16 ) | (( uint32_t )p[ 3 ] << 24 );
+}
+
+static uint16_t Load16( const uint8_t *p )
+{
+    return ( uint16_t )( p[ 0 ] | ( p[ 1 ] << 8 ));
+}
+
+static const char *OpcodeName( uint8_t opcode )
+{
+    for( size_t n = 0; n < ( sizeof( s_opcodes ) / sizeof( s_opcodes[ 0 ] )); n++ )
+    {
+        if( s_opcodes[ n ].opcode == opcode )
+        {
+            return s_opcodes[ n ].name;
+        }
+    }
+
+    return "?";
+}
+
+static int CompareU32( const void *a, const void *b )
+{
+    uint32_t x = *( const uint32_t* )a;
+    uint32_t y = *( const uint32_t* )b;
+
+    return ( x > y ) - ( x < y );
+}
+
+/**
+ * @brief  Read the whole dump file
+ */
+static uint8_t *LoadFile( const char *path, size_t *size )
+{
+    FILE *file = fopen( path, "rb" );
+    uint8_t *data = NULL;
+    long length;
+
+    if( NULL == file )
+    {
+        return NULL;
+    }
+
+    if(( 0 == fseek( file, 0, SEEK_END )) && (( length = ftell( file )) > 0 ) && ( 0 == fseek( file, 0, SEEK_SET )))
+    {
+        data = malloc(( size_t )length );
+
+        if(( NULL != data ) && ( fread( data, 1, ( size_t )length, file ) != ( size_t )length ))
+        {
+            free( data );
+            data = NULL;
+        }
+        *size = ( size_t )length;
+    }
+
+    fclose( file );
+
+    return data;
+}
+
+/**
+ * @brief  Per-opcode latency summary over the decoded records
+ */
+static void PrintSummary( const sRecord_t *records, uint32_t count )
+{
+    uint32_t *samples = malloc(( count + 1 ) * sizeof( uint32_t ));
+    uint64_t span_us = ( count > 0 ) ? ( uint32_t )( records[ count - 1 ].end_us - records[ 0 ].start_us ) : 0;
+    uint64_t busy_us = 0;
+
+    if( NULL == samples )
+    {
+        return;
+    }
+
+    printf( "\n%-7s %7s %9s %9s %7s %7s %7s %7s %7s\n", "op", "count", "bytes", "total_us", "min_us", "p50_us", "p99_us", "max_us", "errors" );
+
+    for( uint32_t opcode = 0; opcode < 256; opcode++ )
+    {
+        uint32_t n = 0;
+        uint32_t errors = 0;
+        uint64_t bytes = 0;
+        uint64_t total_us = 0;
+
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            if( records[ i ].opcode == opcode )
+            {
+                samples[ n ] = records[ i ].end_us - records[ i ].start_us;
+                total_us += samples[ n ];
+                bytes += records[ i ].length;
+                errors += ( 0 == records[ i ].status ) ? 1 : 0;
+                n++;
+            }
+        }
+
+        if( 0 == n )
+        {
+            continue;
+        }
+
+        qsort( samples, n, sizeof( uint32_t ), CompareU32 );
+        busy_us += total_us;
+
+        printf( "%-7s %7lu %9llu %9llu %7lu %7lu %7lu %7lu %7lu\n", OpcodeName(( uint8_t )opcode ), ( unsigned long )n,
+                ( unsigned long long )bytes, ( unsigned long long )total_us, ( unsigned long )samples[ 0 ],
+                ( unsigned long )samples[ n / 2 ], ( unsigned long )samples[(( n * 99 ) - 1 ) / 100 ],
+                ( unsigned long )samples[ n - 1 ], ( unsigned long )errors );
+    }
+
+    printf( "\n%lu transactions over %llu us, CS low %llu us (%llu%%)\n", ( unsigned long )count, ( unsigned long long )span_us,
+            ( unsigned long long )busy_us, ( unsigned long long )(( 0 != span_us ) ? (( busy_us * 100 ) / span_us ) : 0 ));
+
+    free( samples );
+}
+
+/**
+ * @details Usage: trace_decode <dump> [-s]   (-s: summary only)
+ */
+int main( int argc, char **argv )
+{
+    size_t size = 0;
+    uint8_t *data;
+
+    if( argc < 2 )
+    {
+        fprintf( stderr, "usage: %s <dump> [-s]\n", argv[ 0 ] );
+        return 2;
+    }
+
+    if( NULL == ( data = LoadFile( argv[ 1 ], &size )))
+    {
+        fprintf( stderr, "%s: cannot read\n", argv[ 1 ] );
+        return 1;
+    }
+
+    uint32_t record_size = ( size >= TRACE_HEADER_SIZE ) ? Load16( data + 4 ) : 0;
+    uint32_t entries = ( size >= TRACE_HEADER_SIZE ) ? Load16( data + 6 ) : 0;
+
+    if(( size < TRACE_HEADER_SIZE ) || ( TRACE_MAGIC != Load32( data )) || ( record_size < TRACE_RECORD_SIZE ) || ( 0 == entries )
+        || ( size < ( TRACE_HEADER_SIZE + (( size_t )record_size * entries ))))
+    {
+        fprintf( stderr, "%s: not a complete IS25LP trace dump\n", argv[ 1 ] );
+        free( data );
+        return 1;
+    }
+
+    uint32_t head = Load32( data + 8 );
+    uint32_t count = ( head < entries ) ? head : entries;
+
+    // The slot at head is overwritten by the transaction that was running
+    if(( 0 != data[ 12 ] ) && ( count == entries ))
+    {
+        count--;
+    }
+
+    sRecord_t *records = malloc(( count + 1 ) * sizeof( sRecord_t ));
+
+    if( NULL == records )
+    {
+        free( data );
+        return 1;
+    }
+
+    // Oldest first
+    for( uint32_t i = 0; i < count; i++ )
+    {
+        const uint8_t *p = data + TRACE_HEADER_SIZE + (( size_t )(( head - count + i ) % entries ) * record_size );
+
+        records[ i ].start_us = Load32( p );
+        records[ i ].end_us = Load32( p + 4 );
+        records[ i ].address = Load32( p + 8 );
+        records[ i ].length = Load16( p + 12 );
+        records[ i ].opcode = p[ 14 ];
+        records[ i ].status = p[ 15 ];
+    }
+
+    if(( argc < 3 ) || ( 0 != strcmp( argv[ 2 ], "-s" )))
+    {
+        printf( "%8s %10s %8s %8s  %-7s %8s %6s\n", "seq", "start_us", "gap_us", "dur_us", "op", "address", "bytes" );
+
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            const sRecord_t *r = &records[ i ];
+            uint32_t gap = ( i > 0 ) ? ( r->start_us - records[ i - 1 ].end_us ) : 0;
+            char address[ 12 ] = "-";
+
+            if( TRACE_NO_ADDRESS != r->address )
+            {
+                snprintf( address, sizeof( address ), "0x%06lX", ( unsigned long )r->address );
+            }
+
+            printf( "%8lu %10lu %8lu %8lu  %-7s %8s %6u%s\n", ( unsigned long )( head - count + i ),
+                    ( unsigned long )( r->start_us - records[ 0 ].start_us ), ( unsigned long )gap,
+                    ( unsigned long )( r->end_us - r->start_us ), OpcodeName( r->opcode ), address,
+                    ( unsigned )r->length, ( 0 == r->status ) ? "  ERROR" : "" );
+        }
+    }
+
+    PrintSummary( records, count );
+
+    free( records );
+    free( data );
+
+    return 0;
+}